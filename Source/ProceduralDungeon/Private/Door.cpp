@@ -19,7 +19,10 @@
 
 ADoor::ADoor()
 {
+	// The door state is updated by events, tick is only needed by the subclasses using it.
+	// The C++ subclasses overriding Tick must enable it (Blueprint ones with an Event Tick are handled in PostInitializeComponents).
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	bReplicates = true;
 	bAlwaysRelevant = true; // prevent the doors from despawning on clients when server's player is too far
 	NetDormancy = ENetDormancy::DORM_DormantAll;
@@ -40,11 +43,55 @@ void ADoor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimePro
 	DOREPLIFETIME_WITH_PARAMS(ADoor, RoomB, Params);
 }
 
+void ADoor::BeginPlay()
+{
+	Super::BeginPlay();
+	UpdateDoorState();
+}
+
+void ADoor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Keep the Blueprint doors using Event Tick ticking like before.
+	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AActor, ReceiveTick)))
+		PrimaryActorTick.bStartWithTickEnabled = true;
+
+#if ENABLE_DRAW_DEBUG
+	// Needs to tick to draw the debug in the door's blueprint editor.
+	if (GetWorld() && GetWorld()->WorldType == EWorldType::EditorPreview)
+		SetActorTickEnabled(true);
+#endif
+}
+
+void ADoor::PostNetReceive()
+{
+	Super::PostNetReceive();
+
+	// Update the door when its state or its rooms are replicated.
+	// This also restores the door visibility computed locally if the server's one has been replicated.
+	UpdateDoorState();
+}
+
 // Called every frame
 void ADoor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+#if ENABLE_DRAW_DEBUG
+	// TODO: Place it in an editor module of the plugin
+	if (Dungeon::DrawDebug() && GetWorld()->WorldType == EWorldType::EditorPreview)
+	{
+		FDoorDef DoorDef;
+		DoorDef.Direction = EDoorDirection::NbDirection;
+		DoorDef.Type = Type;
+		FDoorDef::DrawDebug(GetWorld(), DoorDef);
+	}
+#endif // ENABLE_DRAW_DEBUG
+}
+
+void ADoor::UpdateDoorState()
+{
 	// Tells if the door actor has been spawned by the dungeon generator or not.
 	// At least one of the room is valid when spawned by the dungeon generator.
 	// Both rooms are invalid if door has been spawned by another way.
@@ -63,10 +110,7 @@ void ADoor::Tick(float DeltaTime)
 		// - The Room Culling is enabled.
 		// - The door is not `Always Visible`.
 		// - Both connected rooms are not visible.
-		// @TODO: this should not work with multiplayer games, because bHidden is replicated!
-		// It works only because it is updated each frame on clients too!
-		// The behavior will change if bHidden is updated once in a wile by an event instead!
-		// So, I should find another way to hide the actor... (avoiding if possible RootComponent::SetVisible)
+		// bHidden is replicated, so it is computed again on clients each time the door is replicated (see PostNetReceive).
 		SetActorHiddenInGame(Dungeon::OcclusionCulling()
 			&& !bAlwaysVisible
 			&& !(bRoomAVisible || bRoomBVisible)
@@ -104,6 +148,15 @@ void ADoor::Tick(float DeltaTime)
 	if (bIsOpen != bPrevIsOpen)
 	{
 		DungeonLog_Debug("Door %s open: %d", *GetNameSafe(this), bIsOpen);
+
+		// The closed doors may hide the rooms behind them.
+		if (bSpawnedByDungeon)
+		{
+			const URoom* Room = IsValid(RoomA) ? RoomA : RoomB;
+			if (ADungeonGeneratorBase* Generator = Room->GetTypedOuter<ADungeonGeneratorBase>())
+				Generator->NotifyDoorOpenChanged(this);
+		}
+
 		if (bIsOpen)
 		{
 			OnDoorOpen();
@@ -115,17 +168,6 @@ void ADoor::Tick(float DeltaTime)
 			OnDoorClose_BP();
 		}
 	}
-
-#if ENABLE_DRAW_DEBUG
-	// TODO: Place it in an editor module of the plugin
-	if (Dungeon::DrawDebug() && GetWorld()->WorldType == EWorldType::EditorPreview)
-	{
-		FDoorDef DoorDef;
-		DoorDef.Direction = EDoorDirection::NbDirection;
-		DoorDef.Type = Type;
-		FDoorDef::DrawDebug(GetWorld(), DoorDef);
-	}
-#endif // ENABLE_DRAW_DEBUG
 }
 
 void ADoor::SetConnectingRooms(URoom* _RoomA, URoom* _RoomB)
@@ -133,6 +175,19 @@ void ADoor::SetConnectingRooms(URoom* _RoomA, URoom* _RoomB)
 	check(HasAuthority());
 	SET_ACTOR_REPLICATED_PROPERTY_VALUE(RoomA, _RoomA);
 	SET_ACTOR_REPLICATED_PROPERTY_VALUE(RoomB, _RoomB);
+	UpdateDoorState();
+}
+
+void ADoor::Recycle()
+{
+	check(HasAuthority());
+	SetConnectingRooms(nullptr, nullptr);
+	SET_ACTOR_REPLICATED_PROPERTY_VALUE(bShouldBeOpen, false);
+	SET_ACTOR_REPLICATED_PROPERTY_VALUE(bShouldBeLocked, false);
+	UpdateDoorState();
+
+	OnDoorRecycled();
+	OnDoorRecycled_BP();
 }
 
 void ADoor::Open(bool bOpen)
@@ -141,6 +196,7 @@ void ADoor::Open(bool bOpen)
 		return;
 
 	SET_ACTOR_REPLICATED_PROPERTY_VALUE(bShouldBeOpen, bOpen);
+	UpdateDoorState();
 }
 
 void ADoor::Lock(bool bLock)
@@ -149,4 +205,5 @@ void ADoor::Lock(bool bLock)
 		return;
 
 	SET_ACTOR_REPLICATED_PROPERTY_VALUE(bShouldBeLocked, bLock)
+	UpdateDoorState();
 }
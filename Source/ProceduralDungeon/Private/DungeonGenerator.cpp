@@ -29,6 +29,14 @@ bool ADungeonGenerator::CreateDungeon_Implementation()
 	if (!HasAuthority())
 		return false;
 
+	// The generation will continue in the next frames with ContinueDungeonCreation.
+	if (bUseWorldCollisionChecks && bUseAsyncWorldCollisionChecks)
+	{
+		ResetAsyncGeneration();
+		AsyncTriesLeft = Dungeon::MaxGenerationTryBeforeGivingUp();
+		return StartAsyncGenerationTry();
+	}
+
 	// Maybe move from plugin settings to generator's variable?
 	int TriesLeft = Dungeon::MaxGenerationTryBeforeGivingUp();
 	bool ValidDungeon = false;
@@ -43,18 +51,8 @@ bool ADungeonGenerator::CreateDungeon_Implementation()
 
 		// Create the list with the correct mode (depth or breadth)
 		TQueueOrStack<URoom*>::EMode listMode;
-		switch (GenerationType)
-		{
-		case EGenerationType::DFS:
-			listMode = TQueueOrStack<URoom*>::EMode::STACK;
-			break;
-		case EGenerationType::BFS:
-			listMode = TQueueOrStack<URoom*>::EMode::QUEUE;
-			break;
-		default:
-			DungeonLog_Error("GenerationType value is not supported.");
+		if (!GetListMode(listMode))
 			return false;
-		}
 
 		URoomData* def = ChooseFirstRoomData();
 		if (!IsValid(def))
@@ -102,7 +100,82 @@ bool ADungeonGenerator::CreateDungeon_Implementation()
 	return true;
 }
 
-bool ADungeonGenerator::AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRooms)
+bool ADungeonGenerator::ExpandDungeon_Implementation()
+{
+	if (!HasAuthority())
+		return false;
+
+	TQueueOrStack<URoom*>::EMode listMode;
+	if (!GetListMode(listMode))
+		return false;
+
+	TQueueOrStack<URoom*> roomStack(listMode);
+	TArray<URoom*> expandedRooms;
+	TArray<URoom*> newRooms;
+
+	URoom* branchRoot = nullptr;
+	int32 branchDoor = -1;
+	if (GetBranchToRegenerate(branchRoot, branchDoor))
+	{
+		// Start only from the freed door
+		AddNewRooms(*branchRoot, newRooms, branchDoor);
+		expandedRooms.Append(newRooms);
+		for (URoom* room : newRooms)
+		{
+			roomStack.Push(room);
+		}
+	}
+	else
+	{
+		// Start from the existing rooms having some unconnected doors
+		for (URoom* room : Graph->GetAllRooms())
+		{
+			check(IsValid(room));
+			if (!room->AreAllDoorsConnected())
+				roomStack.Push(room);
+		}
+	}
+
+	while (!roomStack.IsEmpty())
+	{
+		URoom* currentRoom = roomStack.Pop();
+		check(IsValid(currentRoom)); // currentRoom should always be valid
+
+		const bool bShouldContinue = AddNewRooms(*currentRoom, newRooms);
+		expandedRooms.Append(newRooms);
+		if (!bShouldContinue)
+			break;
+
+		for (URoom* room : newRooms)
+		{
+			roomStack.Push(room);
+		}
+	}
+
+	// Only the new rooms have to be initialized, the existing ones are already loaded
+	Graph->InitRooms(expandedRooms);
+
+	DungeonLog_Info("Dungeon has grown by %d rooms.", expandedRooms.Num());
+	return true;
+}
+
+bool ADungeonGenerator::GetListMode(TQueueOrStack<URoom*>::EMode& OutMode) const
+{
+	switch (GenerationType)
+	{
+	case EGenerationType::DFS:
+		OutMode = TQueueOrStack<URoom*>::EMode::STACK;
+		return true;
+	case EGenerationType::BFS:
+		OutMode = TQueueOrStack<URoom*>::EMode::QUEUE;
+		return true;
+	default:
+		DungeonLog_Error("GenerationType value is not supported.");
+		return false;
+	}
+}
+
+bool ADungeonGenerator::AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRooms, int32 OnlyDoorIndex)
 {
 	check(HasAuthority());
 
@@ -118,7 +191,7 @@ bool ADungeonGenerator::AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRoom
 	bool shouldContinue = false;
 	for (int i = 0; shouldContinue = ContinueToAddRoom(), i < nbDoor && shouldContinue; ++i)
 	{
-		if (ParentRoom.IsConnected(i))
+		if (ParentRoom.IsConnected(i) || (OnlyDoorIndex >= 0 && OnlyDoorIndex != i) || !CanExpandDoor(ParentRoom, i))
 			continue;
 
 		// Get the door definition in its world position and direction
@@ -137,86 +210,239 @@ bool ADungeonGenerator::AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRoom
 		do
 		{
 			nbTries--;
-			bDiscardRoom = false;
-			URoomData* roomDef = ChooseNextRoomData(ParentRoom.GetRoomData(), doorDef, doorIndex);
-			if (!IsValid(roomDef))
-			{
-				bDiscardRoom |= bAutoDiscardRoomIfNull;
-				if (bDiscardRoom)
-				{
-					break;
-				}
-				else
-				{
-					DungeonLog_Error("ChooseNextRoomData returned null.");
-					continue;
-				}
-			}
+			newRoom = TryCreateNextRoom(ParentRoom, doorDef, newRoomDoor, DungeonBounds, bUseWorldCollisionChecks, World, doorIndex);
+		} while (nbTries > 0 && newRoom == nullptr && !bDiscardRoom);
 
-			if (doorIndex >= roomDef->Doors.Num())
-			{
-				DungeonLog_Error("ChooseNextRoomData returned door index '%d' which is out of range in the RoomData '%s' door list (max: %d).", doorIndex, *roomDef->GetName(), roomDef->Doors.Num() - 1);
-				continue;
-			}
+		// If we explicitely want to not place a room, then goes to next door
+		if (bDiscardRoom)
+			continue;
+
+		// Plugin-wide setting is deprecated, will be removed in v4.0
+		const bool bConnectAllDoors = bCanLoop && Dungeon::CanLoop();
+		if (AddRoomToDungeon(newRoom, bConnectAllDoors ? TArray<int> {} : TArray<int> {doorIndex}))
+		{
+			AddedRooms.Add(newRoom);
+		}
+		else // No room can be placed and all placement tries exhausted
+		{
+			// @TODO: Find a way to move this call in AddRoomToDungeon
+			OnFailedToAddRoom(ParentRoom.GetRoomData(), doorDef);
+		}
+	}
+	
+	// Maybe move from plugin settings to generator's variable?
+	const bool bRoomLimitReached = Graph->Count() > Dungeon::RoomLimit();
+	if (bRoomLimitReached)
+	{
+		DungeonLog_Warning("Dungeon has reached the room limit of %d! Check your 'Continue To Add Room' to make sure your dungeon is not in an infinite loop, or increase the room limit in the plugin settings if this is intentional.", Dungeon::RoomLimit());
+	}
+
+	return shouldContinue && !bRoomLimitReached;
+}
+
+URoom* ADungeonGenerator::TryCreateNextRoom(URoom& ParentRoom, const FDoorDef& DoorDef, const FDoorDef& NewRoomDoor, const FBoxMinAndMax& DungeonBounds, bool bCheckWorldCollision, const UWorld* World, int& DoorIndex)
+{
+	bDiscardRoom = false;
+	URoomData* roomDef = ChooseNextRoomData(ParentRoom.GetRoomData(), DoorDef, DoorIndex);
+	if (!IsValid(roomDef))
+	{
+		bDiscardRoom |= bAutoDiscardRoomIfNull;
+		if (!bDiscardRoom)
+		{
+			DungeonLog_Error("ChooseNextRoomData returned null.");
+		}
+		return nullptr;
+	}
+
+	if (DoorIndex >= roomDef->Doors.Num())
+	{
+		DungeonLog_Error("ChooseNextRoomData returned door index '%d' which is out of range in the RoomData '%s' door list (max: %d).", DoorIndex, *roomDef->GetName(), roomDef->Doors.Num() - 1);
+		return nullptr;
+	}
+
+	// Get all compatible door indices from the chosen room data
+	TArray<int> compatibleDoors;
+	roomDef->GetCompatibleDoors(DoorDef, compatibleDoors);
+	if (compatibleDoors.Num() <= 0)
+	{
+		DungeonLog_Error("ChooseNextRoomData returned room data '%s' with no compatible door (door type: '%s').", *roomDef->GetName(), *DoorDef.GetTypeName());
+		return nullptr;
+	}
+
+	// Get only doors if the new room could fit in the dungeon bounds
+	for (int n = compatibleDoors.Num() - 1; n >= 0; --n)
+	{
+		if (!roomDef->IsRoomInBounds(DungeonBounds, compatibleDoors[n], NewRoomDoor))
+			compatibleDoors.RemoveAt(n);
+	}
+
+	if (compatibleDoors.Num() <= 0)
+	{
+		DungeonLog_Warning("ChooseNextRoomData returned room data '%s' that could not fit in dungeon bounds.", *roomDef->GetName());
+		return nullptr;
+	}
+
+	if (roomDef->RandomDoor || (DoorIndex < 0))
+		DoorIndex = compatibleDoors[GetRandomStream().RandRange(0, compatibleDoors.Num() - 1)];
+	else if (!compatibleDoors.Contains(DoorIndex))
+	{
+		DungeonLog_Error("ChooseNextRoomData returned door index '%d' (RoomData '%s') which its type '%s' is not compatible with '%s'.", DoorIndex, *roomDef->GetName(), *roomDef->Doors[DoorIndex].GetTypeName(), *DoorDef.GetTypeName());
+		return nullptr;
+	}
+
+	// Create new room instance from roomdef
+	URoom* newRoom = CreateRoomInstance(roomDef);
+
+	// Place the room at targeted door position if possible
+	if (!TryPlaceRoom(newRoom, DoorIndex, NewRoomDoor, bCheckWorldCollision, World))
+	{
+		// The object will be automatically deleted by the GC
+		return nullptr;
+	}
+
+	return newRoom;
+}
 
-			// Get all compatible door indices from the chosen room data
-			TArray<int> compatibleDoors;
-			roomDef->GetCompatibleDoors(doorDef, compatibleDoors);
-			if (compatibleDoors.Num() <= 0)
+// ===== Time-sliced generation =====
+
+bool ADungeonGenerator::IsDungeonCreationPending() const
+{
+	return AsyncRoomStack.IsValid();
+}
+
+EGenerationResult ADungeonGenerator::ContinueDungeonCreation()
+{
+	// Wait for the world collision checks of the current door.
+	if (AsyncCandidates.Num() > 0 && !ResolveDoorCandidates())
+		return EGenerationResult::None;
+
+	while (true)
+	{
+		if (!IsValid(AsyncParentRoom))
+		{
+			if (bAsyncShouldContinue && !AsyncRoomStack->IsEmpty())
 			{
-				DungeonLog_Error("ChooseNextRoomData returned room data '%s' with no compatible door (door type: '%s').", *roomDef->GetName(), *doorDef.GetTypeName());
+				AsyncParentRoom = AsyncRoomStack->Pop();
+				AsyncDoorIndex = 0;
 				continue;
 			}
 
-			// Get only doors if the new room could fit in the dungeon bounds
-			for (int n = compatibleDoors.Num() - 1; n >= 0; --n)
+			// No more room to process, the current try is finished.
+			// Initialize the dungeon by eg. altering the room instances
+			FinalizeDungeon();
+			if (IsValidDungeon())
 			{
-				if (!roomDef->IsRoomInBounds(DungeonBounds, compatibleDoors[n], newRoomDoor))
-					compatibleDoors.RemoveAt(n);
+				ResetAsyncGeneration();
+				return EGenerationResult::Success;
 			}
 
-			if (compatibleDoors.Num() <= 0)
+			if (AsyncTriesLeft <= 0)
 			{
-				DungeonLog_Warning("ChooseNextRoomData returned room data '%s' that could not fit in dungeon bounds.", *roomDef->GetName());
-				continue;
+				DungeonLog_Error("Generated dungeon is not valid after %d tries. Make sure your ChooseNextRoomData and IsValidDungeon functions are correct.", Dungeon::MaxGenerationTryBeforeGivingUp());
+				ResetAsyncGeneration();
+				return EGenerationResult::Error;
 			}
 
-			if (roomDef->RandomDoor || (doorIndex < 0))
-				doorIndex = compatibleDoors[GetRandomStream().RandRange(0, compatibleDoors.Num() - 1)];
-			else if (!compatibleDoors.Contains(doorIndex))
+			if (!StartAsyncGenerationTry())
 			{
-				DungeonLog_Error("ChooseNextRoomData returned door index '%d' (RoomData '%s') which its type '%s' is not compatible with '%s'.", doorIndex, *roomDef->GetName(), *roomDef->Doors[doorIndex].GetTypeName(), *doorDef.GetTypeName());
-				continue;
+				ResetAsyncGeneration();
+				return EGenerationResult::Error;
 			}
+			continue;
+		}
+
+		if (RequestNextDoorCandidates())
+			return EGenerationResult::None;
+	}
+}
+
+bool ADungeonGenerator::StartAsyncGenerationTry()
+{
+	TQueueOrStack<URoom*>::EMode listMode;
+	if (!GetListMode(listMode))
+		return false;
+
+	URoomData* def = nullptr;
+	do
+	{
+		if (AsyncTriesLeft <= 0)
+		{
+			DungeonLog_Error("Generated dungeon is not valid after %d tries. Make sure your ChooseNextRoomData and IsValidDungeon functions are correct.", Dungeon::MaxGenerationTryBeforeGivingUp());
+			return false;
+		}
+
+		AsyncTriesLeft--;
+		AsyncRoomStack = MakeUnique<TQueueOrStack<URoom*>>(listMode);
+		AsyncParentRoom = nullptr;
+		bAsyncShouldContinue = true;
 
-			// Create new room instance from roomdef
-			newRoom = CreateRoomInstance(roomDef);
-		
-			// Place the room at targeted door position if possible
-			if (!TryPlaceRoom(newRoom, doorIndex, newRoomDoor, World))
+		// Reset generation data
+		StartNewDungeon();
+
+		// Like the synchronous generation, the try is consumed without finalizing an empty dungeon.
+		def = ChooseFirstRoomData();
+		if (!IsValid(def))
+			DungeonLog_Error("ChooseFirstRoomData returned null.");
+	} while (!IsValid(def));
+
+	// Create the first room
+	URoom* root = CreateRoomInstance(def);
+	AddRoomToDungeon(root, /*DoorsToConnect = */ {}, /*bFailIfNotConnected = */ false);
+	AsyncRoomStack->Push(root);
+	return true;
+}
+
+bool ADungeonGenerator::RequestNextDoorCandidates()
+{
+	check(HasAuthority());
+	check(IsValid(AsyncParentRoom));
+
+	URoom& ParentRoom = *AsyncParentRoom;
+	const int nbDoor = ParentRoom.GetRoomData()->GetNbDoor();
+	if (nbDoor <= 0)
+		DungeonLog_Error("The room data '%s' has no door! Nothing could be generated with it!", *GetNameSafe(ParentRoom.GetRoomData()));
+
+	const UWorld* World = GetWorld();
+	const FBoxMinAndMax DungeonBounds = DungeonLimits.GetBox();
+
+	bool shouldContinue = false;
+	for (; shouldContinue = ContinueToAddRoom(), AsyncDoorIndex < nbDoor && shouldContinue; ++AsyncDoorIndex)
+	{
+		if (ParentRoom.IsConnected(AsyncDoorIndex) || !CanExpandDoor(ParentRoom, AsyncDoorIndex))
+			continue;
+
+		const FDoorDef doorDef = ParentRoom.GetDoorDef(AsyncDoorIndex);
+		const FDoorDef newRoomDoor = doorDef.GetOpposite();
+		if (!DungeonBounds.IsInside(newRoomDoor.Position))
+			continue;
+
+		// Create all the candidates at once, only the world collision is not checked yet.
+		int nbTries = Dungeon::MaxRoomPlacementTryBeforeGivingUp();
+		int doorIndex = -1;
+		do
+		{
+			nbTries--;
+			URoom* newRoom = TryCreateNextRoom(ParentRoom, doorDef, newRoomDoor, DungeonBounds, /*bCheckWorldCollision = */ false, World, doorIndex);
+			if (newRoom != nullptr)
 			{
-				// The object will be automatically deleted by the GC
-				newRoom = nullptr;
+				AsyncCandidates.Add(newRoom);
+				AsyncCandidateDoorIndices.Add(doorIndex);
+				AsyncCandidateHandles.Add(RequestWorldCollisionCheck(newRoom));
 			}
-		} while (nbTries > 0 && newRoom == nullptr);
+		} while (nbTries > 0 && !bDiscardRoom);
+
+		// A discard only stops the creation of the candidates: the sync path would have placed one of the previous ones.
+		if (AsyncCandidates.Num() > 0)
+			return true;
 
 		// If we explicitely want to not place a room, then goes to next door
 		if (bDiscardRoom)
 			continue;
 
-		// Plugin-wide setting is deprecated, will be removed in v4.0
-		const bool bConnectAllDoors = bCanLoop && Dungeon::CanLoop();
-		if (AddRoomToDungeon(newRoom, bConnectAllDoors ? TArray<int> {} : TArray<int> {doorIndex}))
-		{
-			AddedRooms.Add(newRoom);
-		}
-		else // No room can be placed and all placement tries exhausted
-		{
-			// @TODO: Find a way to move this call in AddRoomToDungeon
-			OnFailedToAddRoom(ParentRoom.GetRoomData(), doorDef);
-		}
+		// No room can be placed and all placement tries exhausted
+		OnFailedToAddRoom(ParentRoom.GetRoomData(), doorDef);
 	}
-	
+
 	// Maybe move from plugin settings to generator's variable?
 	const bool bRoomLimitReached = Graph->Count() > Dungeon::RoomLimit();
 	if (bRoomLimitReached)
@@ -224,7 +450,71 @@ bool ADungeonGenerator::AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRoom
 		DungeonLog_Warning("Dungeon has reached the room limit of %d! Check your 'Continue To Add Room' to make sure your dungeon is not in an infinite loop, or increase the room limit in the plugin settings if this is intentional.", Dungeon::RoomLimit());
 	}
 
-	return shouldContinue && !bRoomLimitReached;
+	bAsyncShouldContinue = shouldContinue && !bRoomLimitReached;
+	AsyncParentRoom = nullptr;
+	return false;
+}
+
+bool ADungeonGenerator::ResolveDoorCandidates()
+{
+	check(IsValid(AsyncParentRoom));
+
+	// Wait until all results are available to keep the candidate order.
+	TArray<bool> Collisions;
+	Collisions.SetNum(AsyncCandidates.Num());
+	for (int i = 0; i < AsyncCandidates.Num(); ++i)
+	{
+		if (!GetWorldCollisionResult(AsyncCandidateHandles[i], AsyncCandidates[i], Collisions[i]))
+			return false;
+	}
+
+	URoom* newRoom = nullptr;
+	int doorIndex = -1;
+	for (int i = 0; i < AsyncCandidates.Num(); ++i)
+	{
+		if (!Collisions[i])
+		{
+			newRoom = AsyncCandidates[i];
+			doorIndex = AsyncCandidateDoorIndices[i];
+			break;
+		}
+	}
+
+	AsyncCandidates.Reset();
+	AsyncCandidateDoorIndices.Reset();
+	AsyncCandidateHandles.Reset();
+
+	// Plugin-wide setting is deprecated, will be removed in v4.0
+	const bool bConnectAllDoors = bCanLoop && Dungeon::CanLoop();
+	if (AddRoomToDungeon(newRoom, bConnectAllDoors ? TArray<int> {} : TArray<int> {doorIndex}))
+	{
+		AsyncRoomStack->Push(newRoom);
+	}
+	else if (!bDiscardRoom) // No room can be placed and all placement tries exhausted
+	{
+		OnFailedToAddRoom(AsyncParentRoom->GetRoomData(), AsyncParentRoom->GetDoorDef(AsyncDoorIndex));
+	}
+
+	// Continue with the next door of the parent room.
+	++AsyncDoorIndex;
+	return true;
+}
+
+void ADungeonGenerator::ResetAsyncGeneration()
+{
+	AsyncRoomStack.Reset();
+	AsyncParentRoom = nullptr;
+	AsyncCandidates.Empty();
+	AsyncCandidateDoorIndices.Empty();
+	AsyncCandidateHandles.Empty();
+	AsyncDoorIndex = 0;
+	bAsyncShouldContinue = true;
+}
+
+void ADungeonGenerator::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	ResetAsyncGeneration();
+	Super::EndPlay(EndPlayReason);
 }
 
 // ===== Default Native Events Implementations =====
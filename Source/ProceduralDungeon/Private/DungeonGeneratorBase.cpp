@@ -9,6 +9,7 @@
 #include "Engine/Engine.h" // GEngine
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "NavigationSystem.h"
 #include "RoomData.h"
 #include "Room.h"
@@ -29,6 +30,18 @@
 #include "DrawDebugHelpers.h"
 #include "RoomLevel.h"
 #include "Utils/CompatUtils.h"
+#include "Utils/PortalCulling.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectHash.h"
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	#include "AssetRegistryModule.h"
+#else
+	#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+#include "LevelUtils.h"
 
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
 	#define SetNetUpdateFrequency(X) NetUpdateFrequency = X
@@ -206,6 +219,9 @@ void ADungeonGeneratorBase::EndPlay(EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 	if (EndPlayReason == EEndPlayReason::Destroyed)
 		Graph->UnloadAllRooms();
+	UnloadLevelInstancePool();
+	DestroyDoorPool();
+	ReleasePreloadedRoomLevels();
 }
 
 void ADungeonGeneratorBase::Tick(float DeltaTime)
@@ -221,6 +237,73 @@ void ADungeonGeneratorBase::Generate()
 		return;
 
 	EnumAddFlags(Flags, EGeneratorFlags::Generating);
+
+	// A full generation overrides any pending grow request.
+	if (CurrentState == EGenerationState::Idle)
+		EnumRemoveFlags(Flags, EGeneratorFlags::Incremental);
+}
+
+void ADungeonGeneratorBase::Grow()
+{
+	// Do it only on server, do nothing on clients
+	if (!HasAuthority())
+		return;
+
+	if (IsGenerating() || IsLoadingSavedDungeon())
+	{
+		DungeonLog_Warning("Can't grow the dungeon while a generation is in progress.");
+		return;
+	}
+
+	if (Graph->Count() <= 0)
+	{
+		Generate();
+		return;
+	}
+
+	EnumAddFlags(Flags, EGeneratorFlags::Generating | EGeneratorFlags::Incremental);
+}
+
+void ADungeonGeneratorBase::RegenerateBranch(URoom* Root, int32 DoorIndex)
+{
+	// Do it only on server, do nothing on clients
+	if (!HasAuthority())
+		return;
+
+	if (IsGenerating() || IsLoadingSavedDungeon())
+	{
+		DungeonLog_Warning("Can't regenerate a branch of the dungeon while a generation is in progress.");
+		return;
+	}
+
+	if (!IsValid(Root) || !Graph->GetAllRooms().Contains(Root))
+	{
+		DungeonLog_Error("Can't regenerate a branch from room '%s': the room is not in the dungeon.", *GetNameSafe(Root));
+		return;
+	}
+
+	if (!Root->IsDoorIndexValid(DoorIndex))
+	{
+		DungeonLog_Error("Can't regenerate a branch from room '%s': door index %d is out of range.", *GetNameSafe(Root), DoorIndex);
+		return;
+	}
+
+	TArray<URoom*> BranchRooms;
+	Graph->GetBranchRooms(Root, DoorIndex, BranchRooms);
+	DungeonLog_Info("Regenerating branch from room '%s' (door %d): %d rooms removed.", *GetNameSafe(Root), DoorIndex, BranchRooms.Num());
+	Graph->RemoveRooms(BranchRooms);
+
+	BranchRoot = Root;
+	BranchDoorIndex = DoorIndex;
+	++BranchRegenerationCount;
+	EnumAddFlags(Flags, EGeneratorFlags::Generating | EGeneratorFlags::Incremental);
+}
+
+bool ADungeonGeneratorBase::GetBranchToRegenerate(URoom*& OutRoot, int32& OutDoorIndex) const
+{
+	OutRoot = BranchRoot;
+	OutDoorIndex = BranchDoorIndex;
+	return BranchRoot != nullptr;
 }
 
 void ADungeonGeneratorBase::Unload()
@@ -250,11 +333,16 @@ void ADungeonGeneratorBase::FinalizeDungeon()
 URoom* ADungeonGeneratorBase::CreateRoomInstance(URoomData* RoomData)
 {
 	URoom* Instance = NewObject<URoom>(this);
-	Instance->Init(RoomData, this, Graph->Count());
+	Instance->Init(RoomData, this, Graph->GetNextRoomId());
 	return Instance;
 }
 
 bool ADungeonGeneratorBase::TryPlaceRoom(URoom* const& Room, int DoorIndex, const FDoorDef& TargetDoor, const UWorld* World) const
+{
+	return TryPlaceRoom(Room, DoorIndex, TargetDoor, bUseWorldCollisionChecks, World);
+}
+
+bool ADungeonGeneratorBase::TryPlaceRoom(URoom* const& Room, int DoorIndex, const FDoorDef& TargetDoor, bool bCheckWorldCollision, const UWorld* World) const
 {
 	if (!IsValid(Room))
 	{
@@ -271,26 +359,70 @@ bool ADungeonGeneratorBase::TryPlaceRoom(URoom* const& Room, int DoorIndex, cons
 	//bool bCanBePlaced = !FVoxelBounds::Overlap(Room->GetVoxelBounds(), Graph->GetVoxelBounds());
 
 	// Check that it does not collide with the world too
-	if (bCanBePlaced && bUseWorldCollisionChecks)
+	if (bCanBePlaced && bCheckWorldCollision)
 	{
 		if (!World)
 			World = GetWorld();
 
-		const FBoxCenterAndExtent Bounds = Room->GetBounds();
-		const FTransform& DungeonTransform = GetDungeonTransform();
-		const bool bCollideWithWorld = World->OverlapBlockingTestByChannel(
-			DungeonTransform.TransformPositionNoScale(Bounds.Center),
-			DungeonTransform.GetRotation(),
-			ECC_WorldStatic,
-			FCollisionShape::MakeBox(Bounds.Extent),
-			WorldCollisionParams
-		);
+		FVector Center;
+		FQuat Rotation;
+		FCollisionShape Shape;
+		GetWorldCollisionBox(Room, Center, Rotation, Shape);
+		const bool bCollideWithWorld = World->OverlapBlockingTestByChannel(Center, Rotation, ECC_WorldStatic, Shape, WorldCollisionParams);
 		bCanBePlaced &= !bCollideWithWorld;
 	}
 
 	return bCanBePlaced;
 }
 
+FTraceHandle ADungeonGeneratorBase::RequestWorldCollisionCheck(const URoom* Room) const
+{
+	check(IsValid(Room));
+
+	FVector Center;
+	FQuat Rotation;
+	FCollisionShape Shape;
+	GetWorldCollisionBox(Room, Center, Rotation, Shape);
+	return GetWorld()->AsyncOverlapByChannel(Center, Rotation, ECC_WorldStatic, Shape, WorldCollisionParams);
+}
+
+bool ADungeonGeneratorBase::GetWorldCollisionResult(const FTraceHandle& Handle, const URoom* Room, bool& bOutCollide) const
+{
+	UWorld* World = GetWorld();
+	FOverlapDatum Datum;
+	if (World->QueryOverlapData(Handle, Datum))
+	{
+		bOutCollide = false;
+		for (const FOverlapResult& Overlap : Datum.OutOverlaps)
+		{
+			bOutCollide |= Overlap.bBlockingHit;
+		}
+		return true;
+	}
+
+	// Result is not available yet.
+	if (World->IsTraceHandleValid(Handle, /*bOverlapTrace = */ true))
+		return false;
+
+	// The request has expired before we could get its result, so fallback on a synchronous check.
+	DungeonLog_WarningSilent("Asynchronous world collision check has expired for room '%s'.", *GetNameSafe(Room));
+	FVector Center;
+	FQuat Rotation;
+	FCollisionShape Shape;
+	GetWorldCollisionBox(Room, Center, Rotation, Shape);
+	bOutCollide = World->OverlapBlockingTestByChannel(Center, Rotation, ECC_WorldStatic, Shape, WorldCollisionParams);
+	return true;
+}
+
+void ADungeonGeneratorBase::GetWorldCollisionBox(const URoom* Room, FVector& OutCenter, FQuat& OutRotation, FCollisionShape& OutShape) const
+{
+	const FBoxCenterAndExtent Bounds = Room->GetBounds();
+	const FTransform& DungeonTransform = GetDungeonTransform();
+	OutCenter = DungeonTransform.TransformPositionNoScale(Bounds.Center);
+	OutRotation = DungeonTransform.GetRotation();
+	OutShape = FCollisionShape::MakeBox(Bounds.Extent);
+}
+
 bool ADungeonGeneratorBase::AddRoomToDungeon(URoom* const& Room, const TArray<int>& DoorsToConnect, bool bFailIfNotConnected)
 {
 	if (!IsValid(Room))
@@ -322,6 +454,9 @@ bool ADungeonGeneratorBase::AddRoomToDungeon(URoom* const& Room, const TArray<in
 	}
 
 	Graph->AddRoom(Room);
+	if (bPreloadRoomLevels)
+		PreloadRoomLevel(Room->GetRoomData());
+
 	FTransform DungeonTransform = Room->Generator()->GetDungeonTransform();
 	FTransform RoomTransform = Room->GetTransform();
 	// Room->GetLevelScript()
@@ -366,6 +501,27 @@ bool ADungeonGeneratorBase::CreateDungeon_Implementation()
 	return false;
 }
 
+bool ADungeonGeneratorBase::ExpandDungeon_Implementation()
+{
+	DungeonLog_Error("ExpandDungeon is not overriden!");
+	return false;
+}
+
+void ADungeonGeneratorBase::EndDungeonCreation(bool bSuccess)
+{
+	if (bSuccess)
+	{
+		OnGenerationSuccess();
+	}
+	else
+	{
+		// Keep the existing dungeon when it failed to grow.
+		if (!IsIncremental())
+			Graph->Clear();
+		OnGenerationFailed();
+	}
+}
+
 void ADungeonGeneratorBase::ChooseDoorClasses()
 {
 	if (!HasAuthority())
@@ -378,6 +534,10 @@ void ADungeonGeneratorBase::ChooseDoorClasses()
 	{
 		check(IsValid(Conn));
 
+		// Keep the doors already spawned (e.g. when growing the dungeon).
+		if (Conn->IsDoorInstanced())
+			continue;
+
 		const URoom* RoomA = Conn->GetRoomA().Get();
 		const URoom* RoomB = Conn->GetRoomB().Get();
 
@@ -394,82 +554,827 @@ void ADungeonGeneratorBase::ChooseDoorClasses()
 
 void ADungeonGeneratorBase::UpdateRoomVisibility()
 {
-	APawn* Player = GetVisibilityPawn();
-	if (!IsValid(Player))
+	GatherVisibilityPawns();
+	if (VisibilityPawns.Num() <= 0)
 		return;
 
-	// Copied from AActor::GetComponentsBoundingBox but check also collision response with the room object type
-	FBox WorldPlayerBox(ForceInit);
-	Player->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors = */false
-		, [&](const UPrimitiveComponent* Component)
+	const bool bIsOcclusionEnabled = Dungeon::OcclusionCulling();
+	const uint32 OcclusionDistance = Dungeon::OcclusionDistance();
+	const uint32 OcclusionProxyDistance = Dungeon::OcclusionProxyDistance();
+	const bool bIsPortalOcclusionEnabled = bIsOcclusionEnabled && Dungeon::PortalOcclusion();
+	const bool bClosedDoorsOcclude = bIsPortalOcclusionEnabled && Dungeon::ClosedDoorsOcclude();
+	const bool bOcclusionChanged = bWasOcclusionEnabled != bIsOcclusionEnabled || PreviousOcclusionDistance != OcclusionDistance || PreviousOcclusionProxyDistance != OcclusionProxyDistance
+		|| bWasPortalOcclusionEnabled != bIsPortalOcclusionEnabled || bDidClosedDoorsOcclude != bClosedDoorsOcclude;
+
+	// Nothing can change while the pawns do not move and the dungeon and settings stay the same.
+	bool bHavePawnsMoved = VisibilityPawns.Num() != PreviousVisibilityPawns.Num();
+	for (int32 i = 0; !bHavePawnsMoved && i < VisibilityPawns.Num(); ++i)
+	{
+		bHavePawnsMoved = PreviousVisibilityPawns[i].Get() != VisibilityPawns[i] || !VisibilityPawns[i]->GetActorLocation().Equals(PreviousVisibilityPawnLocations[i]);
+	}
+
+	// With the portal occlusion, the visible rooms change also when the cameras turn.
+	bool bHaveViewsMoved = false;
+	if (bIsPortalOcclusionEnabled)
+	{
+		GatherVisibilityViews();
+		bHaveViewsMoved = VisibilityViews.Num() != PreviousVisibilityViews.Num();
+		for (int32 i = 0; !bHaveViewsMoved && i < VisibilityViews.Num(); ++i)
 		{
-			if (Component->IsRegistered()
-				&& Component->IsCollisionEnabled()
-				&& Component->GetCollisionResponseToChannel(Dungeon::RoomObjectType()) != ECollisionResponse::ECR_Ignore
-				)
+			const FVisibilityView& View = VisibilityViews[i];
+			const FVisibilityView& PreviousView = PreviousVisibilityViews[i];
+			bHaveViewsMoved = !View.Location.Equals(PreviousView.Location) || !View.Rotation.Equals(PreviousView.Rotation)
+				|| View.FOV != PreviousView.FOV || View.AspectRatio != PreviousView.AspectRatio;
+		}
+		PreviousVisibilityViews = VisibilityViews;
+	}
+	else
+	{
+		VisibilityViews.Reset();
+		PreviousVisibilityViews.Reset();
+	}
+
+	if (!bIsVisibilityDirty && !bOcclusionChanged && !bHavePawnsMoved && !bHaveViewsMoved)
+		return;
+
+	PreviousVisibilityPawns.SetNum(VisibilityPawns.Num());
+	PreviousVisibilityPawnLocations.SetNum(VisibilityPawns.Num());
+	for (int32 i = 0; i < VisibilityPawns.Num(); ++i)
+	{
+		PreviousVisibilityPawns[i] = VisibilityPawns[i];
+		PreviousVisibilityPawnLocations[i] = VisibilityPawns[i]->GetActorLocation();
+	}
+
+	const FTransform Transform = UseGeneratorTransform() ? GetTransform() : FTransform::Identity;
+	TSet<URoom*> PlayerRooms;
+	for (const APawn* Player : VisibilityPawns)
+	{
+		// Copied from AActor::GetComponentsBoundingBox but check also collision response with the room object type
+		FBox WorldPlayerBox(ForceInit);
+		Player->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors = */false
+			, [&](const UPrimitiveComponent* Component)
 			{
-				WorldPlayerBox += Component->Bounds.GetBox();
-			}
-		});
+				if (Component->IsRegistered()
+					&& Component->IsCollisionEnabled()
+					&& Component->GetCollisionResponseToChannel(Dungeon::RoomObjectType()) != ECollisionResponse::ECR_Ignore
+					)
+				{
+					WorldPlayerBox += Component->Bounds.GetBox();
+				}
+			});
+
+		WorldPlayerBox = WorldPlayerBox.InverseTransformBy(Transform);
+
+		// The cells overlapped by the player are looked up directly in the dungeon grid.
+		// The octree is only used when the player box overlaps more cells than there are rooms to test.
+		if (!Graph->GetRoomsInBox(WorldPlayerBox, PlayerRooms, Graph->Count()))
+		{
+			FindElementsWithBoundsTest(*Octree, WorldPlayerBox, [&PlayerRooms](const FDungeonOctreeElement& Element) {
+				PlayerRooms.Add(Element.Room);
+			});
+		}
+	}
 
-	FTransform Transform = UseGeneratorTransform() ? GetTransform() : FTransform::Identity;
-	WorldPlayerBox = WorldPlayerBox.InverseTransformBy(Transform);
+	const bool bPlayerRoomsChanged = PlayerRooms.Num() != CurrentPlayerRooms.Num() || !PlayerRooms.Includes(CurrentPlayerRooms);
+	if (!bIsVisibilityDirty && !bOcclusionChanged && !bPlayerRoomsChanged && !bHaveViewsMoved)
+		return;
 
-	TSet<URoom*> RoomsToHide(CurrentPlayerRooms);
-	CurrentPlayerRooms.Empty();
-	FindElementsWithBoundsTest(*Octree, WorldPlayerBox, [this, &RoomsToHide](const FDungeonOctreeElement& Element) {
-		RoomsToHide.Remove(Element.Room);
-		CurrentPlayerRooms.Add(Element.Room);
-		Element.Room->SetPlayerInside(true);
-	});
+	for (URoom* Room : CurrentPlayerRooms)
+	{
+		if (!PlayerRooms.Contains(Room))
+			Room->SetPlayerInside(false);
+	}
 
-	for (URoom* room : RoomsToHide)
+	for (URoom* Room : PlayerRooms)
 	{
-		room->SetPlayerInside(false);
+		if (!CurrentPlayerRooms.Contains(Room))
+			Room->SetPlayerInside(true);
 	}
 
-	const bool bIsOcclusionEnabled = Dungeon::OcclusionCulling();
-	const uint32 OcclusionDistance = Dungeon::OcclusionDistance();
+	CurrentPlayerRooms = MoveTemp(PlayerRooms);
+	bIsVisibilityDirty = false;
 
 	// Detects occlusion setting changes and toggles on/off all room visibilities when occlusion is enabled/disabled.
-	if (bWasOcclusionEnabled != bIsOcclusionEnabled
-		|| PreviousOcclusionDistance != OcclusionDistance)
+	if (bOcclusionChanged)
 	{
-		RoomsToHide.Empty();
+		VisibleRooms.Empty();
 		for (URoom* Room : Graph->GetAllRooms())
 		{
 			Room->SetVisible(!bIsOcclusionEnabled);
 		}
+
+		for (URoom* Room : ProxyRooms)
+		{
+			SetRoomProxyVisible(Room, false);
+		}
+		ProxyRooms.Empty();
 	}
 	bWasOcclusionEnabled = bIsOcclusionEnabled;
 	PreviousOcclusionDistance = OcclusionDistance;
+	PreviousOcclusionProxyDistance = OcclusionProxyDistance;
+	bWasPortalOcclusionEnabled = bIsPortalOcclusionEnabled;
+	bDidClosedDoorsOcclude = bClosedDoorsOcclude;
 
 	// Don't change room visibilities if occlusion is disabled.
 	if (!bIsOcclusionEnabled)
 		return;
 
-	TSet<URoom*> VisibleRooms;
-	UDungeonGraph::TraverseRooms(CurrentPlayerRooms, &VisibleRooms, OcclusionDistance, [](URoom* room) { room->SetVisible(true); });
-	UDungeonGraph::TraverseRooms(RoomsToHide, nullptr, OcclusionDistance, [&VisibleRooms](URoom* room) { room->SetVisible(VisibleRooms.Contains(room)); });
+	// Only the rooms entering or leaving the visible set are updated.
+	TSet<URoom*> NewVisibleRooms;
+	if (bIsPortalOcclusionEnabled && VisibilityViews.Num() > 0)
+	{
+		// The rooms where the pawns are stay visible, even when the cameras are outside of them.
+		if (OcclusionDistance > 0)
+			NewVisibleRooms.Append(CurrentPlayerRooms);
+
+		for (const FVisibilityView& View : VisibilityViews)
+		{
+			GetRoomsInView(View, OcclusionDistance, bClosedDoorsOcclude, NewVisibleRooms);
+		}
+	}
+	else
+	{
+		// The rooms visible from all the pawns are gathered at once from the distance table and the potentially visible sets.
+		Graph->GetVisibleRoomsInDistance(CurrentPlayerRooms, OcclusionDistance, NewVisibleRooms);
+	}
+
+	for (URoom* Room : VisibleRooms)
+	{
+		if (!NewVisibleRooms.Contains(Room))
+			Room->SetVisible(false);
+	}
+
+	for (URoom* Room : NewVisibleRooms)
+	{
+		if (!VisibleRooms.Contains(Room))
+			Room->SetVisible(true);
+	}
+
+	VisibleRooms = MoveTemp(NewVisibleRooms);
+
+	// The rooms just beyond the visible ones show their proxy mesh instead of nothing.
+	TSet<URoom*> NewProxyRooms;
+	if (OcclusionProxyDistance > 0)
+	{
+		Graph->GetVisibleRoomsInDistance(CurrentPlayerRooms, OcclusionDistance + OcclusionProxyDistance, NewProxyRooms);
+		for (URoom* Room : VisibleRooms)
+		{
+			NewProxyRooms.Remove(Room);
+		}
+	}
+
+	for (URoom* Room : ProxyRooms)
+	{
+		if (!NewProxyRooms.Contains(Room))
+			SetRoomProxyVisible(Room, false);
+	}
+
+	for (URoom* Room : NewProxyRooms)
+	{
+		if (!ProxyRooms.Contains(Room))
+			SetRoomProxyVisible(Room, true);
+	}
+
+	ProxyRooms = MoveTemp(NewProxyRooms);
+}
+
+void ADungeonGeneratorBase::GetVisibilityPawnRooms(TSet<URoom*>& OutRooms)
+{
+	OutRooms.Empty();
+	GatherVisibilityPawns();
+	for (const APawn* Player : VisibilityPawns)
+	{
+		const FVector LocalLocation = GetDungeonTransform().InverseTransformPositionNoScale(Player->GetActorLocation());
+		URoom* Room = Graph->GetRoomAt(Dungeon::ToRoomLocation(LocalLocation));
+		if (IsValid(Room))
+			OutRooms.Add(Room);
+	}
+}
+
+void ADungeonGeneratorBase::GatherVisibilityPawns()
+{
+	VisibilityPawns.Reset();
+	GetVisibilityPawns(VisibilityPawns);
+	VisibilityPawns.RemoveAll([](const APawn* Pawn) { return !IsValid(Pawn); });
+}
+
+void ADungeonGeneratorBase::GatherVisibilityViews()
+{
+	VisibilityViews.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (!IsValid(Controller) || !Controller->IsLocalController() || !IsValid(Controller->PlayerCameraManager))
+			continue;
+
+		const FMinimalViewInfo& CameraView = Controller->PlayerCameraManager->GetCameraCachePOV();
+		FVisibilityView& View = VisibilityViews.AddDefaulted_GetRef();
+		View.Location = CameraView.Location;
+		View.Rotation = CameraView.Rotation;
+		View.FOV = CameraView.FOV;
+		View.AspectRatio = CameraView.AspectRatio;
+
+		// The aspect ratio of the camera is only used when it is constrained, else the viewport one is used.
+		int32 ViewportX = 0;
+		int32 ViewportY = 0;
+		Controller->GetViewportSize(ViewportX, ViewportY);
+		if (!CameraView.bConstrainAspectRatio && ViewportX > 0 && ViewportY > 0)
+			View.AspectRatio = static_cast<float>(ViewportX) / ViewportY;
+	}
+}
+
+void ADungeonGeneratorBase::GetRoomsInView(const FVisibilityView& View, uint32 MaxDepth, bool bClosedDoorsOcclude, TSet<URoom*>& OutRooms) const
+{
+	if (MaxDepth == 0)
+		return;
+
+	struct FPortalStep
+	{
+		URoom* Room;
+		const URoomConnection* FromConnection;
+		FPortalFrustum Frustum;
+		uint32 Depth;
+	};
+
+	const FTransform& DungeonTransform = GetDungeonTransform();
+	const FVector LocalLocation = DungeonTransform.InverseTransformPositionNoScale(View.Location);
+	URoom* ViewRoom = Graph->GetRoomAt(Dungeon::ToRoomLocation(LocalLocation));
+	if (!IsValid(ViewRoom))
+		return;
+
+	TArray<FPortalStep> Steps;
+	Steps.Add({ViewRoom, nullptr, FPortalFrustum(View.Location, View.Rotation, View.FOV, View.AspectRatio), 1});
+
+	// A room can be seen through several paths, so it can be visited again with another frustum.
+	// The depth limit stops the traversal in the loops.
+	while (Steps.Num() > 0)
+	{
+		const FPortalStep Step = Steps.Pop();
+		OutRooms.Add(Step.Room);
+
+		if (Step.Depth >= MaxDepth)
+			continue;
+
+		for (int32 i = 0; i < Step.Room->GetConnectionCount(); ++i)
+		{
+			const URoomConnection* Connection = Step.Room->GetConnection(i);
+			if (!IsValid(Connection) || Connection == Step.FromConnection)
+				continue;
+
+			URoom* OtherRoom = URoomConnection::GetOtherRoom(Connection, Step.Room);
+			if (!IsValid(OtherRoom))
+				continue;
+
+			const ADoor* Door = Connection->GetDoorInstance();
+			if (bClosedDoorsOcclude && IsValid(Door) && !Door->IsOpen())
+				continue;
+
+			// The portal is the door bounds flattened along the door direction.
+			const FDoorDef DoorDef = Step.Room->GetDoorDef(i);
+			const FBoxCenterAndExtent Bounds = DoorDef.GetBounds();
+			const bool bAlongX = (DoorDef.Direction == EDoorDirection::North || DoorDef.Direction == EDoorDirection::South);
+			const FVector Width = bAlongX ? FVector(0, Bounds.Extent.Y, 0) : FVector(Bounds.Extent.X, 0, 0);
+			const FVector Height(0, 0, Bounds.Extent.Z);
+			const FVector Center(Bounds.Center);
+			const FVector Corners[4] = {
+				DungeonTransform.TransformPositionNoScale(Center - Width - Height),
+				DungeonTransform.TransformPositionNoScale(Center + Width - Height),
+				DungeonTransform.TransformPositionNoScale(Center + Width + Height),
+				DungeonTransform.TransformPositionNoScale(Center - Width + Height),
+			};
+
+			if (!Step.Frustum.IntersectsQuad(Corners))
+				continue;
+
+			Steps.Add({OtherRoom, Connection, Step.Frustum.ClipThroughQuad(Corners), Step.Depth + 1});
+		}
+	}
+}
+
+void ADungeonGeneratorBase::SetRoomProxyVisible(URoom* Room, bool bVisible)
+{
+	UStaticMeshComponent* Proxy = RoomProxies.FindRef(Room);
+	if (IsValid(Proxy))
+	{
+		Proxy->SetVisibility(bVisible);
+		return;
+	}
+
+	if (!bVisible || GetNetMode() == NM_DedicatedServer)
+		return;
+
+	const URoomData* Data = Room->GetRoomData();
+	if (!IsValid(Data) || Data->ProxyMesh.IsNull())
+		return;
+
+	// The component is created once the mesh is loaded.
+	UStaticMesh* Mesh = Data->ProxyMesh.Get();
+	if (!IsValid(Mesh))
+	{
+		LoadPackageAsync(Data->ProxyMesh.GetLongPackageName(), FLoadPackageAsyncDelegate::CreateUObject(this, &ADungeonGeneratorBase::OnRoomProxyMeshLoaded));
+		return;
+	}
+
+	Proxy = NewObject<UStaticMeshComponent>(this);
+	Proxy->SetMobility(EComponentMobility::Movable);
+	Proxy->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Proxy->SetCanEverAffectNavigation(false);
+	Proxy->SetCastShadow(false);
+	Proxy->SetStaticMesh(Mesh);
+	Proxy->SetWorldTransform(Room->GetTransform() * GetDungeonTransform());
+	Proxy->RegisterComponent();
+	RoomProxies.Add(Room, Proxy);
+}
+
+void ADungeonGeneratorBase::OnRoomProxyMeshLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	if (Result != EAsyncLoadingResult::Succeeded || !IsValid(Package))
+	{
+		DungeonLog_WarningSilent("Failed to load room proxy mesh package: %s", *PackageName.ToString());
+		return;
+	}
+
+	// Creates the components of the rooms still waiting for this mesh.
+	for (URoom* Room : ProxyRooms)
+	{
+		const URoomData* Data = IsValid(Room) ? Room->GetRoomData() : nullptr;
+		if (IsValid(Data) && FName(*Data->ProxyMesh.GetLongPackageName()) == PackageName && !RoomProxies.Contains(Room))
+			SetRoomProxyVisible(Room, true);
+	}
+}
+
+void ADungeonGeneratorBase::DestroyRoomProxy(URoom* Room)
+{
+	UStaticMeshComponent* Proxy = nullptr;
+	if (RoomProxies.RemoveAndCopyValue(Room, Proxy) && IsValid(Proxy))
+		Proxy->DestroyComponent();
+}
+
+void ADungeonGeneratorBase::DestroyRoomProxies()
+{
+	for (const auto& Pair : RoomProxies)
+	{
+		if (IsValid(Pair.Value))
+			Pair.Value->DestroyComponent();
+	}
+	RoomProxies.Empty();
+	ProxyRooms.Empty();
+}
+
+bool ADungeonGeneratorBase::AreRoomsReadyToPlay()
+{
+	// The streamed rooms are never all loaded, so wait only for the ones queued.
+	int32 Distance = PlayableRoomDistance;
+	if (StreamingDistance >= 0)
+		Distance = (Distance < 0) ? MAX_int32 : FMath::Min(Distance, StreamingDistance);
+
+	// The doors are queued by the same distance as the rooms.
+	const bool bAreDoorsSpawned = Graph->AreNearDoorsSpawned((Distance < 0) ? MAX_int32 : Distance, CachedTmpDoorCount, CachedTmpDoorTotal);
+
+	// All the rooms not initialized yet are queued.
+	return Graph->AreNearRoomsInitialized((Distance < 0) ? MAX_int32 : Distance, CachedTmpRoomCount, CachedTmpRoomTotal) && bAreDoorsSpawned;
+}
+
+void ADungeonGeneratorBase::UpdateBackgroundRoomLoading()
+{
+	if (!bIsLoadingRoomsInBackground)
+		return;
+
+	Graph->UpdateDoorSpawning(MaxDoorSpawnsPerFrame);
+	Graph->UpdateRoomLoading(MaxConcurrentRoomLoads);
+
+	int32 NbRoomInitialized = 0;
+	int32 NbRoomToInitialize = 0;
+	if (Graph->HasRoomsToLoad() || Graph->HasDoorsToSpawn() || !Graph->AreNearRoomsInitialized(MAX_int32, NbRoomInitialized, NbRoomToInitialize))
+		return;
+
+	DungeonLog_Info("All rooms have been loaded in background.");
+	bIsLoadingRoomsInBackground = false;
+	UnloadLevelInstancePool();
+	DestroyDoorPool();
+	ReleasePreloadedRoomLevels();
+	RebuildNavmesh();
+}
+
+void ADungeonGeneratorBase::UpdateRoomStreaming()
+{
+	// Let the background loading finish before streaming the rooms.
+	if (StreamingDistance < 0 || bIsLoadingRoomsInBackground)
+		return;
+
+	// The streamed rooms are instantiated progressively, like the ones of the generation.
+	Graph->UpdateRoomLoading(MaxConcurrentRoomLoads);
+
+	TSet<URoom*> PlayerRooms;
+	GetPlayerRooms(PlayerRooms);
+	if (PlayerRooms.Num() <= 0)
+		return;
+
+	const bool bPlayerRoomsChanged = PlayerRooms.Num() != StreamingPlayerRooms.Num() || !PlayerRooms.Includes(StreamingPlayerRooms);
+	if (!bPlayerRoomsChanged && !bIsRoomStreamingDirty)
+		return;
+
+	StreamingPlayerRooms = MoveTemp(PlayerRooms);
+	bIsRoomStreamingDirty = false;
+
+	// The rooms are unloaded one step farther than they are loaded,
+	// so a player moving back and forth through a door does not reload the same room each time.
+	TSet<URoom*> RoomsToLoad;
+	TSet<URoom*> RoomsToKeep;
+	// The traversal distance includes the player rooms, hence the +1.
+	Graph->GetRoomsInDistance(StreamingPlayerRooms, StreamingDistance + 1, RoomsToLoad);
+	Graph->GetRoomsInDistance(StreamingPlayerRooms, StreamingDistance + 2, RoomsToKeep);
+
+	for (URoom* Room : Graph->GetAllRooms())
+	{
+		check(IsValid(Room));
+		if (Room->Instance == nullptr)
+		{
+			if (RoomsToLoad.Contains(Room))
+			{
+				if (!Graph->IsRoomLoadQueued(Room))
+				{
+					DungeonLog_Debug("Streaming in room '%s'.", *Room->GetName());
+					Graph->QueueRoomLoad(Room);
+				}
+			}
+			else if (!RoomsToKeep.Contains(Room))
+			{
+				// The player has gone away before the room has been instantiated.
+				Graph->CancelRoomLoad(Room);
+			}
+		}
+		else if (!RoomsToKeep.Contains(Room))
+		{
+			if (Room->IsInstanceInitialized())
+			{
+				DungeonLog_Debug("Streaming out room '%s'.", *Room->GetName());
+				Room->StreamOut();
+			}
+			else
+			{
+				// Still loading, it will be streamed out once initialized.
+				bIsRoomStreamingDirty = true;
+			}
+		}
+	}
+}
+
+void ADungeonGeneratorBase::GetPlayerRooms(TSet<URoom*>& OutRooms)
+{
+	// The rooms of the local pawns are already found each frame by UpdateRoomVisibility.
+	OutRooms = CurrentPlayerRooms;
+
+	// On server, the rooms of the remote players must be kept loaded too for their replicated actors.
+	if (!HasAuthority() || GetNetMode() == NM_Standalone)
+		return;
+
+	const FTransform& DungeonTransform = GetDungeonTransform();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (!IsValid(Controller) || Controller->IsLocalController())
+			continue;
+
+		const APawn* Pawn = Controller->GetPawnOrSpectator();
+		if (!IsValid(Pawn))
+			continue;
+
+		const FVector LocalLocation = DungeonTransform.InverseTransformPositionNoScale(Pawn->GetActorLocation());
+		URoom* Room = Graph->GetRoomAt(Dungeon::ToRoomLocation(LocalLocation));
+		if (IsValid(Room))
+			OutRooms.Add(Room);
+	}
+}
+
+void ADungeonGeneratorBase::RebuildNavmesh()
+{
+	UNavigationSystemV1* nav = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (nullptr == nav || !bRebuildNavmesh)
+		return;
+
+	if (bRebuildNavmeshInRoomsOnly)
+	{
+		DungeonLog_Info("Rebuild navmesh in %d room areas", NavmeshDirtyAreas.Num());
+		for (const FBox& Area : NavmeshDirtyAreas)
+		{
+			nav->AddDirtyArea(Area, ENavigationDirtyFlag::All);
+		}
+		NavmeshDirtyAreas.Reset();
+		return;
+	}
+
+	DungeonLog_Info("Rebuild navmesh");
+
+	// With a dynamic navmesh, we don't need anymore to call Build explicitly
+	// Moreover, removing the build lock triggers a rebuild itself.
+	nav->CancelBuild();
+	nav->Build();
+}
+
+void ADungeonGeneratorBase::AddNavmeshDirtyRoom(const URoom* Room)
+{
+	if (!bRebuildNavmesh || !bRebuildNavmeshInRoomsOnly)
+		return;
+
+	check(IsValid(Room));
+	const FBox LocalBox = Room->GetBounds().GetBox().ExpandBy(Dungeon::RoomUnit());
+	NavmeshDirtyAreas.Add(LocalBox.TransformBy(GetDungeonTransform()));
+}
+
+void ADungeonGeneratorBase::CollectUnloadedLevels()
+{
+	switch (Dungeon::UnloadGarbageCollection())
+	{
+	case EUnloadGarbageCollection::Blocking:
+		GetWorld()->FlushLevelStreaming();
+		GEngine->ForceGarbageCollection(/*bFullPurge = */ true);
+		break;
+	case EUnloadGarbageCollection::Incremental:
+		GEngine->ForceGarbageCollection(/*bFullPurge = */ false);
+		break;
+	case EUnloadGarbageCollection::Deferred:
+		break;
+	default:
+		checkNoEntry();
+		break;
+	}
+}
+
+void ADungeonGeneratorBase::UnloadLevelInstancePool()
+{
+	for (auto& Pair : LevelInstancePool)
+	{
+		for (const TWeakObjectPtr<ULevelStreamingDynamic>& Instance : Pair.Value)
+		{
+			if (Instance.IsValid())
+				Instance->SetIsRequestingUnloadAndRemoval(true);
+		}
+	}
+
+	if (LevelInstancePool.Num() > 0)
+		DungeonLog_InfoSilent("Unloaded the unused pooled room levels.");
+	LevelInstancePool.Empty();
+}
+
+void ADungeonGeneratorBase::PreloadRoomLevels(const TArray<URoomData*>& RoomDataList)
+{
+	for (const URoomData* Data : RoomDataList)
+	{
+		PreloadRoomLevel(Data);
+	}
+}
+
+void ADungeonGeneratorBase::PreloadRoomLevel(const URoomData* Data)
+{
+	if (!IsValid(Data))
+		return;
+
+	const TSoftObjectPtr<UWorld>& Level = Data->GetLevelToLoad(GetWorld());
+	if (Level.IsNull())
+		return;
+
+	const FName LevelPackageName(*Level.GetLongPackageName());
+	bool bAlreadyRequested = false;
+	PreloadingRoomLevels.Add(LevelPackageName, &bAlreadyRequested);
+	if (bAlreadyRequested)
+		return;
+
+	// The level instances are loaded in uniquely named packages, so the world package itself would just be a second copy of the level.
+	// Only its dependencies are preloaded, and then shared with the level instances.
+	TArray<FName> Dependencies;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.GetDependencies(LevelPackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	DungeonLog_Debug("Preloading %d dependencies of room level package: %s", Dependencies.Num(), *LevelPackageName.ToString());
+
+	for (const FName& Dependency : Dependencies)
+	{
+		const FString DependencyName = Dependency.ToString();
+		if (FPackageName::IsScriptPackage(DependencyName))
+			continue;
+
+		PreloadingRoomLevels.Add(Dependency, &bAlreadyRequested);
+		if (bAlreadyRequested)
+			continue;
+
+		LoadPackageAsync(DependencyName, FLoadPackageAsyncDelegate::CreateUObject(this, &ADungeonGeneratorBase::OnRoomLevelPreloaded));
+	}
+}
+
+void ADungeonGeneratorBase::OnRoomLevelPreloaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	if (Result != EAsyncLoadingResult::Succeeded || !IsValid(Package))
+	{
+		DungeonLog_WarningSilent("Failed to preload room level dependency: %s", *PackageName.ToString());
+		return;
+	}
+
+	// The preloaded levels may have been released before the end of the loading.
+	if (!PreloadingRoomLevels.Contains(PackageName))
+		return;
+
+	ForEachObjectWithPackage(Package, [this](UObject* Object) {
+		PreloadedRoomAssets.Add(Object);
+		return true;
+	}, /*bIncludeNestedObjects = */ false);
+}
+
+void ADungeonGeneratorBase::ReleasePreloadedRoomLevels()
+{
+	PreloadingRoomLevels.Empty();
+	PreloadedRoomAssets.Empty();
+}
+
+ULevelStreamingDynamic* ADungeonGeneratorBase::AcquireLevelInstance(const TSoftObjectPtr<UWorld>& Level, const FTransform& Transform)
+{
+	TArray<TWeakObjectPtr<ULevelStreamingDynamic>>* Instances = LevelInstancePool.Find(Level.ToSoftObjectPath());
+	if (Instances == nullptr)
+		return nullptr;
+
+	for (int32 i = 0; i < Instances->Num(); ++i)
+	{
+		ULevelStreamingDynamic* Instance = (*Instances)[i].Get();
+		ULevel* LoadedLevel = IsValid(Instance) ? Instance->GetLoadedLevel() : nullptr;
+		if (!IsValid(LoadedLevel))
+		{
+			Instances->RemoveAtSwap(i--);
+			continue;
+		}
+
+		// Wait for the level to be fully hidden, so its actors receive their BeginPlay again when shown.
+		if (LoadedLevel->bIsVisible)
+			continue;
+
+		Instances->RemoveAtSwap(i);
+
+		// Move the actors from the previous location of the level to the new one.
+		const FTransform DeltaTransform = Instance->LevelTransform.Inverse() * Transform;
+		FLevelUtils::ApplyLevelTransform(LoadedLevel, DeltaTransform, /*bDoPostEditMove = */ false);
+		LoadedLevel->bAlreadyMovedActors = true;
+		Instance->LevelTransform = Transform;
+
+		Instance->SetShouldBeVisible(true);
+		return Instance;
+	}
+
+	return nullptr;
+}
+
+bool ADungeonGeneratorBase::ReleaseLevelInstance(const TSoftObjectPtr<UWorld>& Level, ULevelStreamingDynamic* Instance)
+{
+	if (!bReuseRoomLevels || GetNetMode() != NM_Standalone || IsActorBeingDestroyed())
+		return false;
+
+	// Only the fully loaded levels can be reused.
+	if (!IsValid(Instance) || !IsValid(Instance->GetLoadedLevel()) || Level.IsNull())
+		return false;
+
+	if (ARoomLevel* Script = Cast<ARoomLevel>(Instance->GetLoadedLevel()->GetLevelScriptActor()))
+		Script->Recycle();
+
+	Instance->SetShouldBeVisible(false);
+	LevelInstancePool.FindOrAdd(Level.ToSoftObjectPath()).Add(Instance);
+	return true;
+}
+
+ADoor* ADungeonGeneratorBase::AcquireDoor(TSubclassOf<ADoor> DoorClass, const FTransform& Transform)
+{
+	TArray<TWeakObjectPtr<ADoor>>* Doors = DoorPool.Find(DoorClass.Get());
+	if (Doors == nullptr)
+		return nullptr;
+
+	while (Doors->Num() > 0)
+	{
+		ADoor* Door = Doors->Pop().Get();
+		if (!IsValid(Door))
+			continue;
+
+		Door->SetActorTransform(Transform);
+		Door->SetActorHiddenInGame(false);
+		Door->SetActorEnableCollision(true);
+		Door->SetActorTickEnabled(Door->PrimaryActorTick.bStartWithTickEnabled);
+		Door->FlushNetDormancy();
+		return Door;
+	}
+
+	return nullptr;
+}
+
+bool ADungeonGeneratorBase::ReleaseDoor(ADoor* Door)
+{
+	if (!bReuseDoors || !HasAuthority() || IsActorBeingDestroyed() || !IsValid(Door))
+		return false;
+
+	Door->Recycle();
+	Door->SetActorHiddenInGame(true);
+	Door->SetActorEnableCollision(false);
+	Door->SetActorTickEnabled(false);
+	Door->FlushNetDormancy();
+	DoorPool.FindOrAdd(Door->GetClass()).Add(Door);
+	return true;
+}
+
+void ADungeonGeneratorBase::DestroyDoorPool()
+{
+	for (auto& Pair : DoorPool)
+	{
+		for (const TWeakObjectPtr<ADoor>& Door : Pair.Value)
+		{
+			if (Door.IsValid())
+				Door->Destroy();
+		}
+	}
+	DoorPool.Empty();
+}
+
+void ADungeonGeneratorBase::NotifyRoomReady(const URoom* Room)
+{
+	Graph->OnRoomReady(Room);
+}
+
+void ADungeonGeneratorBase::NotifyRoomLoaded(const URoom* Room)
+{
+	Graph->OnRoomLoaded(Room);
+}
+
+void ADungeonGeneratorBase::NotifyRoomInitialized(const URoom* Room)
+{
+	Graph->OnRoomInitialized(Room);
+}
+
+void ADungeonGeneratorBase::NotifyRoomUnloaded(const URoom* Room)
+{
+	Graph->OnRoomUnloaded(Room);
+}
+
+void ADungeonGeneratorBase::NotifyRoomConnectionsChanged(const URoom* Room)
+{
+	Graph->InvalidateRoomDistances();
+}
+
+void ADungeonGeneratorBase::NotifyDoorOpenChanged(const ADoor* Door)
+{
+	if (Dungeon::PortalOcclusion() && Dungeon::ClosedDoorsOcclude())
+		bIsVisibilityDirty = true;
 }
 
 void ADungeonGeneratorBase::Reset()
 {
 	CurrentPlayerRooms.Empty();
+	StreamingPlayerRooms.Empty();
+	bIsRoomStreamingDirty = true;
+	VisibleRooms.Empty();
+	DestroyRoomProxies();
 	Octree->Destroy();
+	for (URoom* Room : Graph->GetAllRooms())
+	{
+		if (IsValid(Room))
+			Room->ClearOctreeElementId();
+	}
 }
 
 void ADungeonGeneratorBase::UpdateOctree()
 {
-	Octree->Destroy();
+	// Only the new and moved rooms are added, the removed ones are removed when unloaded.
 	for (URoom* r : Graph->GetAllRooms())
 	{
 		check(IsValid(r));
-		FBoxCenterAndExtent bounds = r->GetBounds();
-		FDungeonOctreeElement octreeElement(r);
-		Octree->AddElement(octreeElement);
-		r->SetVisible(false);
+		AddRoomToOctree(r);
+
+		// Rooms already loaded keep their visibility, it will be updated by UpdateRoomVisibility.
+		if (r->Instance == nullptr)
+			r->SetVisible(false);
+	}
+
+	// The room list has changed, the visibilities must be computed again.
+	bIsVisibilityDirty = true;
+}
+
+void ADungeonGeneratorBase::AddRoomToOctree(URoom* Room)
+{
+	const FDungeonOctreeElementId& Id = Room->GetOctreeElementId();
+	if (Id.IsValidId())
+	{
+		// Keep the element if the room has not moved since it has been added.
+		const FBoxCenterAndExtent& OldBounds = Octree->GetElementById(Id).Bounds;
+		const FBoxCenterAndExtent NewBounds = Room->GetBounds();
+		if (OldBounds.Center == NewBounds.Center && OldBounds.Extent == NewBounds.Extent)
+			return;
+
+		RemoveRoomFromOctree(Room);
 	}
+
+	Octree->AddElement(FDungeonOctreeElement(Room));
+}
+
+void ADungeonGeneratorBase::RemoveRoomFromOctree(URoom* Room)
+{
+	const FDungeonOctreeElementId Id = Room->GetOctreeElementId();
+	if (!Id.IsValidId())
+		return;
+
+	Octree->RemoveElement(Id);
+	Room->ClearOctreeElementId();
 }
 
 void ADungeonGeneratorBase::UpdateSeed()
@@ -530,28 +1435,60 @@ void ADungeonGeneratorBase::SetState(EGenerationState NewState)
 void ADungeonGeneratorBase::OnStateBegin(EGenerationState State)
 {
 	CachedTmpRoomCount = 0;
+	CachedTmpRoomTotal = Graph->Count();
+	CachedTmpDoorCount = 0;
+	CachedTmpDoorTotal = 0;
 	switch (State)
 	{
 	case EGenerationState::Unload:
+		if (IsIncremental())
+		{
+			DungeonLog_Info("======= Begin Unload Removed Levels =======");
+			Graph->UnloadRemovedRooms();
+			for (URoom* Room : Graph->GetUnloadingRooms())
+			{
+				CurrentPlayerRooms.Remove(Room);
+				StreamingPlayerRooms.Remove(Room);
+				VisibleRooms.Remove(Room);
+				ProxyRooms.Remove(Room);
+				DestroyRoomProxy(Room);
+				RemoveRoomFromOctree(Room);
+				AddNavmeshDirtyRoom(Room);
+			}
+			DungeonLog_Info("Nb Room To Unload: %d", Graph->GetUnloadingRooms().Num());
+			break;
+		}
 		DungeonLog_Info("======= Begin Unload All Levels =======");
 		Reset();
 		DungeonLog_Info("Nb Room To Unload: %d", Graph->Count());
 		Graph->UnloadAllRooms();
+		for (URoom* Room : Graph->GetUnloadingRooms())
+		{
+			AddNavmeshDirtyRoom(Room);
+		}
 		break;
 	case EGenerationState::Generation:
 		DungeonLog_Info("======= Begin Dungeon Generation =======");
 		check(HasAuthority()); // should never generate on clients!
 		FlushNetDormancy();
-		UpdateSeed();
-		if (CreateDungeon())
+		if (IsIncremental())
 		{
-			OnGenerationSuccess();
-		}
-		else
-		{
-			Graph->Clear();
-			OnGenerationFailed();
+			// Keep the random stream as is, so growing a dungeon stays deterministic for a given seed.
+			// A regenerated branch uses its own sub-seed instead.
+			if (BranchRoot != nullptr)
+			{
+				const int64 Salt = (static_cast<int64>(Seed) << 32) | HashCombine(HashCombine(GetTypeHash(BranchRoot->GetRoomID()), GetTypeHash(BranchDoorIndex)), GetTypeHash(BranchRegenerationCount));
+				InitializeRandomStream(Random::Guid2Seed(Id, Salt));
+				DungeonLog_Info("Branch Seed: %d", Random.GetCurrentSeed());
+			}
+			EndDungeonCreation(ExpandDungeon());
+			break;
 		}
+		UpdateSeed();
+		if (!CreateDungeon())
+			EndDungeonCreation(false);
+		else if (!IsDungeonCreationPending())
+			EndDungeonCreation(true);
 		break;
 	case EGenerationState::Initialization:
 		DungeonLog_Info("======= Begin Dungeon Initialization =======");
@@ -570,10 +1507,25 @@ void ADungeonGeneratorBase::OnStateBegin(EGenerationState State)
 		// but it could be moved during the generation step in a future version
 		// (e.g. in the `FinalizeDungeon` function)
 		ChooseDoorClasses();
-		Graph->LoadAllRooms();
+		{
+			// Load first the rooms near the player
+			TSet<URoom*> StartRooms;
+			GetVisibilityPawnRooms(StartRooms);
+
+			for (URoom* Room : Graph->GetAllRooms())
+			{
+				if (Room->Instance == nullptr)
+					AddNavmeshDirtyRoom(Room);
+			}
+
+			Graph->LoadAllRooms(StartRooms, StreamingDistance);
+			Graph->UpdateDoorSpawning(MaxDoorSpawnsPerFrame);
+			Graph->UpdateRoomLoading(MaxConcurrentRoomLoads);
+		}
 		break;
 	case EGenerationState::Idle:
 		DungeonLog_Info("======= Ready To Play =======");
+		bIsRoomStreamingDirty = true;
 		break;
 	default:
 		checkNoEntry();
@@ -590,12 +1542,24 @@ void ADungeonGeneratorBase::OnStateTick(EGenerationState State)
 		DrawDebug();
 		if (Graph->IsDirty() || IsGenerating() || IsLoadingSavedDungeon())
 			SetState(EGenerationState::Unload);
+		else
+		{
+			UpdateBackgroundRoomLoading();
+			UpdateRoomStreaming();
+		}
 		break;
 	case EGenerationState::Unload:
 		if (Graph->AreRoomsUnloaded(CachedTmpRoomCount))
 			SetState((HasAuthority() && IsGenerating()) ? EGenerationState::Generation : EGenerationState::Initialization);
 		break;
 	case EGenerationState::Generation:
+		if (IsDungeonCreationPending())
+		{
+			const EGenerationResult Result = ContinueDungeonCreation();
+			if (Result == EGenerationResult::None)
+				break;
+			EndDungeonCreation(Result == EGenerationResult::Success);
+		}
 		SetState(EGenerationState::Initialization);
 		break;
 	case EGenerationState::Initialization:
@@ -603,7 +1567,12 @@ void ADungeonGeneratorBase::OnStateTick(EGenerationState State)
 			SetState(EGenerationState::Load);
 		break;
 	case EGenerationState::Load:
-		if (Graph->AreRoomsInitialized(CachedTmpRoomCount))
+		// The existing rooms are still playable while the new ones are loading.
+		if (IsIncremental())
+			UpdateRoomVisibility();
+		Graph->UpdateDoorSpawning(MaxDoorSpawnsPerFrame);
+		Graph->UpdateRoomLoading(MaxConcurrentRoomLoads);
+		if (AreRoomsReadyToPlay())
 			SetState(EGenerationState::Idle);
 		break;
 	default:
@@ -617,6 +1586,10 @@ void ADungeonGeneratorBase::OnStateEnd(EGenerationState State)
 	switch (State)
 	{
 	case EGenerationState::Idle:
+		// Clients don't know if the server has grown the dungeon or generated a new one.
+		if (!HasAuthority() && Graph->IsIncrementalUpdate())
+			EnumAddFlags(Flags, EGeneratorFlags::Incremental);
+
 		OnPreGeneration();
 
 		nav = UNavigationSystemV1::GetCurrent(GetWorld());
@@ -628,13 +1601,22 @@ void ADungeonGeneratorBase::OnStateEnd(EGenerationState State)
 		}
 		break;
 	case EGenerationState::Unload:
+		if (IsIncremental())
+		{
+			// Avoid the hitch of a full flush when nothing has been unloaded.
+			if (Graph->GetUnloadingRooms().Num() > 0)
+				CollectUnloadedLevels();
+			DungeonLog_Info("======= End Unload Removed Levels =======");
+			break;
+		}
 		if (HasAuthority())
 			Graph->Clear();
-		GetWorld()->FlushLevelStreaming();
-		GEngine->ForceGarbageCollection(true);
+		CollectUnloadedLevels();
 		DungeonLog_Info("======= End Unload All Levels =======");
 		break;
 	case EGenerationState::Generation:
+		BranchRoot = nullptr;
+		BranchDoorIndex = -1;
 		DungeonLog_Info("======= End Dungeon Generation =======");
 		break;
 	case EGenerationState::Initialization:
@@ -650,20 +1632,31 @@ void ADungeonGeneratorBase::OnStateEnd(EGenerationState State)
 			DungeonLog_Info("End Loading Dungeon.");
 		}
 
-		EnumRemoveFlags(Flags, EGeneratorFlags::Generating | EGeneratorFlags::LoadSavedDungeon);
+		EnumRemoveFlags(Flags, EGeneratorFlags::Generating | EGeneratorFlags::LoadSavedDungeon | EGeneratorFlags::Incremental);
+
+		// The remaining rooms will be loaded while playing
+		{
+			int32 NbRoomToInitialize = 0;
+			bIsLoadingRoomsInBackground = Graph->HasRoomsToLoad() || Graph->HasDoorsToSpawn() || !Graph->AreNearRoomsInitialized(MAX_int32, CachedTmpRoomCount, NbRoomToInitialize);
+		}
+
+		if (!bIsLoadingRoomsInBackground)
+		{
+			UnloadLevelInstancePool();
+			DestroyDoorPool();
+			ReleasePreloadedRoomLevels();
+		}
 
 		// Try to rebuild the navmesh
 		nav = UNavigationSystemV1::GetCurrent(GetWorld());
 		if (nullptr != nav && bRebuildNavmesh)
 		{
-			DungeonLog_Info("Rebuild navmesh");
-
-			nav->RemoveNavigationBuildLock(ENavigationBuildLock::Custom);
-
-			// With a dynamic navmesh, we don't need anymore to call Build explicitly
-			// Moreover, removing the build lock triggers a rebuild itself.
-			nav->CancelBuild();
-			nav->Build();
+			// Removing the lock would rebuild the whole navmesh otherwise.
+			const auto RebuildAction = bRebuildNavmeshInRoomsOnly
+				? UNavigationSystemV1::ELockRemovalRebuildAction::NoRebuild
+				: UNavigationSystemV1::ELockRemovalRebuildAction::Rebuild;
+			nav->RemoveNavigationBuildLock(ENavigationBuildLock::Custom, RebuildAction);
+			RebuildNavmesh();
 		}
 
 		// Invoke Post Generation Event when initialization is done
@@ -695,6 +1688,17 @@ APawn* ADungeonGeneratorBase::GetVisibilityPawn_Implementation()
 	return Controller->GetPawnOrSpectator();
 }
 
+void ADungeonGeneratorBase::GetVisibilityPawns_Implementation(TArray<APawn*>& OutPawns)
+{
+	OutPawns.AddUnique(GetVisibilityPawn());
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (IsValid(Controller) && Controller->IsLocalController())
+			OutPawns.AddUnique(Controller->GetPawnOrSpectator());
+	}
+}
+
 void ADungeonGeneratorBase::OnPreGeneration_Implementation()
 {
 	OnPreGenerationEvent.Broadcast();
@@ -765,19 +1769,21 @@ void ADungeonGeneratorBase::GetCompatibleRoomData(bool& bSuccess, TArray<URoomDa
 
 float ADungeonGeneratorBase::GetProgress() const
 {
-	const int32 TotalRoom = Graph->Count();
+	const int32 TotalRoom = CachedTmpRoomTotal;
+	const int32 TotalUnloadingRoom = Graph->GetUnloadingRooms().Num();
 	switch (CurrentState)
 	{
 	case EGenerationState::Unload:
-		return (TotalRoom > 0)
-			? 0.5f * (static_cast<float>(CachedTmpRoomCount) / TotalRoom)
+		return (TotalUnloadingRoom > 0)
+			? 0.5f * (static_cast<float>(CachedTmpRoomCount) / TotalUnloadingRoom)
 			: 0.0f;
 	case EGenerationState::Generation:
 	case EGenerationState::Initialization:
 		return 0.5f;
 	case EGenerationState::Load:
-		return (TotalRoom > 0)
-			? 0.5f + 0.5f * (static_cast<float>(CachedTmpRoomCount) / TotalRoom)
+		// The doors are spawned at the same time as the rooms are loaded.
+		return (TotalRoom + CachedTmpDoorTotal > 0)
+			? 0.5f + 0.5f * (static_cast<float>(CachedTmpRoomCount + CachedTmpDoorCount) / (TotalRoom + CachedTmpDoorTotal))
 			: 0.5f;
 	default:
 		return 1.0f;
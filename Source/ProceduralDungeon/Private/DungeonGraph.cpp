@@ -19,6 +19,7 @@
 #include "Engine/LevelStreamingDynamic.h"
 #include "Utils/DungeonSaveUtils.h"
 #include "ProceduralDungeonUtils.h"
+#include "Algo/BinarySearch.h"
 
 void UDungeonGraph::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
@@ -92,17 +93,97 @@ void UDungeonGraph::PostLoadDungeon_Implementation()
 
 void UDungeonGraph::AddRoom(URoom* Room)
 {
-	Rooms.Add(Room);
+	const int32 RoomIndex = Rooms.Add(Room);
+	NextRoomId = FMath::Max(NextRoomId, static_cast<int32>(Room->GetRoomID()) + 1);
 	UpdateBounds(Room);
+	InvalidateRoomDistances();
+
+	// Keeps the cells up to date during the generation, where GetRoomAt is called after each added room.
+	if (RoomCells.Num() > 0)
+		AddRoomCells(Room, RoomIndex, RoomCells);
+}
+
+void UDungeonGraph::RemoveRooms(const TArray<URoom*>& RoomsToRemove)
+{
+	const TSet<URoom*> RemovedSet(RoomsToRemove);
+	for (URoom* Room : RoomsToRemove)
+	{
+		check(IsValid(Room));
+		if (Rooms.Remove(Room) <= 0)
+		{
+			DungeonLog_Warning("Trying to remove room '%s' which is not in the dungeon.", *GetNameSafe(Room));
+			continue;
+		}
+
+		const URoomData* Data = Room->GetRoomData();
+		check(IsValid(Data));
+		Data->CleanupRoom(Room, this);
+
+		for (int32 i = 0; i < Room->GetConnectionCount(); ++i)
+		{
+			URoomConnection* Connection = Room->GetConnection(i);
+			if (!IsValid(Connection))
+				continue;
+
+			URoom* OtherRoom = URoomConnection::GetOtherRoom(Connection, Room);
+			const int32 OtherDoor = URoomConnection::GetOtherDoorId(Connection, Room);
+			RemoveConnection(Connection);
+
+			// The door of a remaining room is now unconnected.
+			if (IsValid(OtherRoom) && !RemovedSet.Contains(OtherRoom))
+				Connect(OtherRoom, OtherDoor, nullptr, -1);
+		}
+
+		RemovedRooms.Add(Room);
+		DungeonLog_Debug("Removed room %s", *GetNameSafe(Room));
+	}
+
+	CompactConnectionIDs();
+	RebuildBounds();
+	InvalidateRoomDistances();
+}
+
+void UDungeonGraph::GetBranchRooms(const URoom* Root, int32 DoorIndex, TArray<URoom*>& OutRooms) const
+{
+	OutRooms.Reset();
+	check(IsValid(Root));
+	if (!Root->IsDoorIndexValid(DoorIndex))
+		return;
+
+	URoom* First = Root->GetConnectedRoom(DoorIndex).Get();
+	if (!IsValid(First) || First == Root)
+		return;
+
+	// Simple flood fill from the room connected to the door, the root room acting as a wall.
+	TSet<const URoom*> Visited({Root, First});
+	OutRooms.Add(First);
+	for (int32 n = 0; n < OutRooms.Num(); ++n)
+	{
+		const URoom* Current = OutRooms[n];
+		for (int32 i = 0; i < Current->GetConnectionCount(); ++i)
+		{
+			URoom* Next = Current->GetConnectedRoom(i).Get();
+			if (!IsValid(Next) || Visited.Contains(Next))
+				continue;
+
+			Visited.Add(Next);
+			OutRooms.Add(Next);
+		}
+	}
 }
 
 void UDungeonGraph::InitRooms()
+{
+	InitRooms(Rooms);
+}
+
+void UDungeonGraph::InitRooms(const TArray<URoom*>& RoomsToInit)
 {
 	// We split the for loops to ensure custom data are created for all rooms before initializing them
 
 	// First create empty connections for remaining unconnected doors
 	TArray<int32> EmptyConnections;
-	for (URoom* Room : Rooms)
+	for (URoom* Room : RoomsToInit)
 	{
 		check(IsValid(Room));
 		Room->GetAllEmptyConnections(EmptyConnections);
@@ -113,7 +194,7 @@ void UDungeonGraph::InitRooms()
 	}
 
 	// Finally we can initialize them all
-	for (URoom* Room : Rooms)
+	for (URoom* Room : RoomsToInit)
 	{
 		// No need to check validity here
 		const URoomData* Data = Room->GetRoomData();
@@ -181,6 +262,13 @@ void UDungeonGraph::RetrieveRoomsFromLoadedData()
 
 	Rooms = TArray<URoom*>(SavedData->Rooms);
 	RoomConnections = TArray<URoomConnection*>(SavedData->Connections);
+	InvalidateRoomDistances();
+
+	NextRoomId = 0;
+	for (const URoom* Room : Rooms)
+	{
+		NextRoomId = FMath::Max(NextRoomId, static_cast<int32>(Room->GetRoomID()) + 1);
+	}
 
 	IDungeonCustomSerialization::DispatchFixupReferences(this, this);
 
@@ -189,12 +277,68 @@ void UDungeonGraph::RetrieveRoomsFromLoadedData()
 
 void UDungeonGraph::Connect(URoom* RoomA, int32 DoorA, URoom* RoomB, int32 DoorB)
 {
+	// Doors left unconnected by a previous generation have an empty connection we need to replace.
+	bool bHasRemovedConnection = false;
+	auto RemoveEmptyConnection = [this, &bHasRemovedConnection](URoom* Room, int32 Door) {
+		if (!IsValid(Room) || !Room->IsDoorIndexValid(Door))
+			return;
+
+		URoomConnection* EmptyConnection = Room->GetConnection(Door);
+		if (IsValid(EmptyConnection))
+		{
+			check(!Room->IsConnected(Door));
+			RemoveConnection(EmptyConnection);
+			bHasRemovedConnection = true;
+		}
+	};
+	RemoveEmptyConnection(RoomA, DoorA);
+	RemoveEmptyConnection(RoomB, DoorB);
+	if (bHasRemovedConnection)
+		CompactConnectionIDs();
+
 	URoomConnection* NewConnection = URoomConnection::CreateConnection(RoomA, DoorA, RoomB, DoorB, this, RoomConnections.Num());
 	RoomConnections.Add(NewConnection);
+	InvalidateRoomDistances();
 	DungeonLog_Debug("Connected %s (%d) to %s (%d)", *GetNameSafe(RoomA), DoorA, *GetNameSafe(RoomB), DoorB);
 	MARK_PROPERTY_DIRTY_FROM_NAME(UDungeonGraph, RoomConnections, this);
 }
 
+void UDungeonGraph::RemoveConnection(URoomConnection* Connection)
+{
+	check(IsValid(Connection));
+
+	if (HasAuthority())
+	{
+		ADoor* Door = Connection->GetDoorInstance();
+		if (IsValid(Door))
+		{
+			DestroyDoor(Door);
+		}
+		Connection->RegisterAsReplicable(false);
+	}
+
+	if (URoom* RoomA = Connection->GetRoomA().Get())
+		RoomA->ClearConnection(Connection->GetRoomADoorId());
+	if (URoom* RoomB = Connection->GetRoomB().Get())
+		RoomB->ClearConnection(Connection->GetRoomBDoorId());
+
+	RoomConnections.Remove(Connection);
+	InvalidateRoomDistances();
+
+	DungeonLog_Debug("Removed connection %s", *GetNameSafe(Connection));
+	MARK_PROPERTY_DIRTY_FROM_NAME(UDungeonGraph, RoomConnections, this);
+}
+
+void UDungeonGraph::CompactConnectionIDs()
+{
+	// Only the connections after a removed one change, the others are not marked dirty again.
+	for (int32 i = 0; i < RoomConnections.Num(); ++i)
+	{
+		if (RoomConnections[i]->GetID() != i)
+			RoomConnections[i]->SetID(i);
+	}
+}
+
 void UDungeonGraph::GetAllRoomsFromData(const URoomData* Data, TArray<URoom*>& OutRooms)
 {
 	GetRoomsByPredicate(OutRooms, [Data](const URoom* Room) { return Room->GetRoomData() == Data; });
@@ -328,7 +472,9 @@ bool UDungeonGraph::GetPathBetween(const URoom* A, const URoom* B, TArray<URoom*
 
 URoom* UDungeonGraph::GetRoomAt(FIntVector RoomCell) const
 {
-	return URoom::GetRoomAt(RoomCell, Rooms);
+	TMap<FIntVector, int32> TmpCells;
+	const int32* Index = GetRoomCells(TmpCells).Find(RoomCell);
+	return (Index != nullptr) ? Rooms[*Index] : nullptr;
 }
 
 FVector UDungeonGraph::GetDungeonBoundsCenter() const
@@ -431,6 +577,8 @@ void UDungeonGraph::Clear()
 	Rooms.Empty();
 
 	RoomConnections.Empty();
+	NextRoomId = 0;
+	InvalidateRoomDistances();
 
 	RebuildBounds();
 }
@@ -496,6 +644,359 @@ void UDungeonGraph::TraverseRooms(const TSet<URoom*>& InRooms, TSet<URoom*>* Out
 		Swap(*OutRooms, closedList);
 }
 
+void UDungeonGraph::GetRoomsInDistance(const TSet<URoom*>& InRooms, uint32 Distance, TSet<URoom*>& OutRooms) const
+{
+	OutRooms.Reset();
+	if (Distance == 0)
+		return;
+
+	CacheRoomIndices();
+	FRoomDistanceTable TmpTable;
+	const FRoomDistanceTable& Table = GetRoomDistanceTable(Distance, TmpTable);
+
+	for (URoom* Room : InRooms)
+	{
+		const int32* Index = RoomIndices.Find(Room);
+		if (Index == nullptr)
+		{
+			// Not a room of this dungeon, nothing to traverse from it.
+			if (IsValid(Room))
+				OutRooms.Add(Room);
+			continue;
+		}
+
+		for (int32 i = Table.Offsets[*Index]; i < Table.Offsets[*Index + 1]; ++i)
+		{
+			OutRooms.Add(Rooms[Table.RoomIndices[i]]);
+		}
+	}
+}
+
+void UDungeonGraph::GetVisibleRoomsInDistance(const TSet<URoom*>& InRooms, uint32 Distance, TSet<URoom*>& OutRooms) const
+{
+	OutRooms.Reset();
+	if (Distance == 0)
+		return;
+
+	CacheRoomIndices();
+	FRoomDistanceTable TmpTable;
+	const FRoomDistanceTable& Table = HasDoorVisibility() ? GetVisibleRoomTable(Distance, TmpTable) : GetRoomDistanceTable(Distance, TmpTable);
+
+	for (URoom* Room : InRooms)
+	{
+		const int32* Index = RoomIndices.Find(Room);
+		if (Index == nullptr)
+		{
+			// Not a room of this dungeon, nothing to traverse from it.
+			if (IsValid(Room))
+				OutRooms.Add(Room);
+			continue;
+		}
+
+		for (int32 i = Table.Offsets[*Index]; i < Table.Offsets[*Index + 1]; ++i)
+		{
+			OutRooms.Add(Rooms[Table.RoomIndices[i]]);
+		}
+	}
+}
+
+void UDungeonGraph::InvalidateRoomDistances()
+{
+	RoomDistanceTables.Empty();
+	RoomIndices.Reset();
+	VisibleRoomTables.Empty();
+	bIsDoorVisibilityCached = false;
+}
+
+bool UDungeonGraph::GetRoomsInBox(const FBox& Box, TSet<URoom*>& OutRooms, int32 MaxCells) const
+{
+	if (!Box.IsValid)
+		return true;
+
+	// Same cell layout as Dungeon::ToWorldLocation: cells are centered on X and Y, and start at their location on Z.
+	const FVector Unit = Dungeon::RoomUnit();
+	const FVector CellOffset(0.5f, 0.5f, 0.0f);
+	const FIntVector MinCell(FMath::FloorToInt(Box.Min.X / Unit.X + CellOffset.X), FMath::FloorToInt(Box.Min.Y / Unit.Y + CellOffset.Y), FMath::FloorToInt(Box.Min.Z / Unit.Z));
+	const FIntVector MaxCell(FMath::FloorToInt(Box.Max.X / Unit.X + CellOffset.X), FMath::FloorToInt(Box.Max.Y / Unit.Y + CellOffset.Y), FMath::FloorToInt(Box.Max.Z / Unit.Z));
+
+	const int64 CellCount = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+	if (CellCount > MaxCells)
+		return false;
+
+	TMap<FIntVector, int32> TmpCells;
+	const TMap<FIntVector, int32>& Cells = GetRoomCells(TmpCells);
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const int32* Index = Cells.Find(FIntVector(X, Y, Z)))
+					OutRooms.Add(Rooms[*Index]);
+			}
+		}
+	}
+	return true;
+}
+
+bool UDungeonGraph::BuildRoomCells(TMap<FIntVector, int32>& OutCells) const
+{
+	OutCells.Reset();
+	bool bIsComplete = true;
+	for (int32 i = 0; i < Rooms.Num(); ++i)
+	{
+		const URoom* Room = Rooms[i];
+		if (!IsValid(Room) || !IsValid(Room->GetRoomData()))
+		{
+			bIsComplete = false;
+			continue;
+		}
+
+		AddRoomCells(Room, i, OutCells);
+	}
+	return bIsComplete;
+}
+
+void UDungeonGraph::AddRoomCells(const URoom* Room, int32 RoomIndex, TMap<FIntVector, int32>& OutCells)
+{
+	const FBoxMinAndMax RoomBox = Room->GetIntBounds();
+	for (int32 X = RoomBox.Min.X; X < RoomBox.Max.X; ++X)
+	{
+		for (int32 Y = RoomBox.Min.Y; Y < RoomBox.Max.Y; ++Y)
+		{
+			for (int32 Z = RoomBox.Min.Z; Z < RoomBox.Max.Z; ++Z)
+			{
+				// Same as URoom::GetRoomAt, the first room wins when some rooms overlap.
+				const FIntVector Cell(X, Y, Z);
+				if (!OutCells.Contains(Cell))
+					OutCells.Add(Cell, RoomIndex);
+			}
+		}
+	}
+}
+
+const TMap<FIntVector, int32>& UDungeonGraph::GetRoomCells(TMap<FIntVector, int32>& TmpCells) const
+{
+	if (RoomCells.Num() > 0 || Rooms.Num() == 0)
+		return RoomCells;
+
+	if (!BuildRoomCells(TmpCells))
+		return TmpCells;
+
+	RoomCells = MoveTemp(TmpCells);
+	return RoomCells;
+}
+
+void UDungeonGraph::CacheRoomIndices() const
+{
+	if (RoomIndices.Num() == Rooms.Num())
+		return;
+
+	RoomIndices.Reset();
+	for (int32 i = 0; i < Rooms.Num(); ++i)
+	{
+		RoomIndices.Add(Rooms[i], i);
+	}
+}
+
+const UDungeonGraph::FRoomDistanceTable& UDungeonGraph::GetRoomDistanceTable(uint32 Distance, FRoomDistanceTable& TmpTable) const
+{
+	if (const FRoomDistanceTable* Table = RoomDistanceTables.Find(Distance))
+		return *Table;
+
+	if (BuildRoomDistanceTable(Distance, TmpTable))
+		return RoomDistanceTables.Add(Distance, MoveTemp(TmpTable));
+	return TmpTable;
+}
+
+bool UDungeonGraph::BuildRoomDistanceTable(uint32 Distance, FRoomDistanceTable& OutTable) const
+{
+	bool bIsComplete = true;
+	OutTable.Offsets.Reset(Rooms.Num() + 1);
+	OutTable.RoomIndices.Reset();
+
+	// Breadth first traversal from each room, using the source room index to mark the visited rooms.
+	TArray<int32> VisitedBy;
+	VisitedBy.Init(INDEX_NONE, Rooms.Num());
+	TArray<int32> Queue;
+	for (int32 Source = 0; Source < Rooms.Num(); ++Source)
+	{
+		OutTable.Offsets.Add(OutTable.RoomIndices.Num());
+		VisitedBy[Source] = Source;
+		Queue.Reset();
+		Queue.Add(Source);
+
+		int32 Begin = 0;
+		for (uint32 Depth = 1; Depth < Distance && Begin < Queue.Num(); ++Depth)
+		{
+			const int32 End = Queue.Num();
+			for (int32 n = Begin; n < End; ++n)
+			{
+				const URoom* Current = Rooms[Queue[n]];
+				for (int32 Door = 0; Door < Current->GetConnectionCount(); ++Door)
+				{
+					const URoomConnection* Connection = Current->GetConnection(Door);
+					const URoom* Next = URoomConnection::GetOtherRoom(Connection, Current);
+					if (!IsValid(Next))
+					{
+						// After InitRooms all the doors have a connection, so a missing one is not replicated yet.
+						if (Connection == nullptr || URoomConnection::GetOtherDoorId(Connection, Current) >= 0)
+							bIsComplete = false;
+						continue;
+					}
+
+					const int32* NextIndex = RoomIndices.Find(Next);
+					if (NextIndex == nullptr || VisitedBy[*NextIndex] == Source)
+						continue;
+
+					VisitedBy[*NextIndex] = Source;
+					Queue.Add(*NextIndex);
+				}
+			}
+			Begin = End;
+		}
+
+		OutTable.RoomIndices.Append(Queue);
+	}
+	OutTable.Offsets.Add(OutTable.RoomIndices.Num());
+
+	return bIsComplete;
+}
+
+const UDungeonGraph::FRoomDistanceTable& UDungeonGraph::GetVisibleRoomTable(uint32 Distance, FRoomDistanceTable& TmpTable) const
+{
+	if (const FRoomDistanceTable* Table = VisibleRoomTables.Find(Distance))
+		return *Table;
+
+	if (BuildVisibleRoomTable(Distance, TmpTable))
+		return VisibleRoomTables.Add(Distance, MoveTemp(TmpTable));
+	return TmpTable;
+}
+
+bool UDungeonGraph::BuildVisibleRoomTable(uint32 Distance, FRoomDistanceTable& OutTable) const
+{
+	bool bIsComplete = true;
+	OutTable.Offsets.Reset(Rooms.Num() + 1);
+	OutTable.RoomIndices.Reset();
+
+	// Each door of the dungeon is a state of the traversal: the room has been entered by this door.
+	TArray<int32> DoorOffsets;
+	DoorOffsets.Reserve(Rooms.Num());
+	int32 DoorCount = 0;
+	for (const URoom* Room : Rooms)
+	{
+		DoorOffsets.Add(DoorCount);
+		DoorCount += Room->GetConnectionCount();
+	}
+
+	// Only the room data with a door visibility baked for their current doors are used.
+	TArray<const URoomData*> DoorVisibilities;
+	DoorVisibilities.Reserve(Rooms.Num());
+	for (const URoom* Room : Rooms)
+	{
+		const URoomData* Data = Room->GetRoomData();
+		DoorVisibilities.Add((IsValid(Data) && Data->HasDoorVisibility()) ? Data : nullptr);
+	}
+
+	// Breadth first traversal of the door states from each room, stopped at the Distance like BuildRoomDistanceTable.
+	// The source room index marks the visited rooms and door states, so they are not cleared for each source.
+	TArray<int32> RoomVisitedBy;
+	RoomVisitedBy.Init(INDEX_NONE, Rooms.Num());
+	TArray<int32> DoorVisitedBy;
+	DoorVisitedBy.Init(INDEX_NONE, DoorCount);
+	TArray<TPair<int32, int32>> Queue; // Room index and the door it has been entered by.
+	for (int32 Source = 0; Source < Rooms.Num(); ++Source)
+	{
+		OutTable.Offsets.Add(OutTable.RoomIndices.Num());
+		OutTable.RoomIndices.Add(Source);
+		RoomVisitedBy[Source] = Source;
+		Queue.Reset();
+		Queue.Emplace(Source, INDEX_NONE);
+
+		int32 Begin = 0;
+		for (uint32 Depth = 1; Depth < Distance && Begin < Queue.Num(); ++Depth)
+		{
+			const int32 End = Queue.Num();
+			for (int32 n = Begin; n < End; ++n)
+			{
+				const TPair<int32, int32> Current = Queue[n];
+				const URoom* Room = Rooms[Current.Key];
+				const URoomData* Visibility = DoorVisibilities[Current.Key];
+				for (int32 Door = 0; Door < Room->GetConnectionCount(); ++Door)
+				{
+					// All the doors are seen from inside the source room, then only the ones seen from the door the room has been entered by.
+					if (Current.Value != INDEX_NONE && (Door == Current.Value || (Visibility && !Visibility->CanDoorSeeDoor(Current.Value, Door))))
+						continue;
+
+					const URoomConnection* Connection = Room->GetConnection(Door);
+					const URoom* Next = URoomConnection::GetOtherRoom(Connection, Room);
+					if (!IsValid(Next))
+					{
+						// After InitRooms all the doors have a connection, so a missing one is not replicated yet.
+						if (Connection == nullptr || URoomConnection::GetOtherDoorId(Connection, Room) >= 0)
+							bIsComplete = false;
+						continue;
+					}
+
+					const int32* NextIndex = RoomIndices.Find(Next);
+					const int32 NextDoor = URoomConnection::GetOtherDoorId(Connection, Room);
+					if (NextIndex == nullptr || NextDoor < 0 || NextDoor >= Next->GetConnectionCount())
+						continue;
+
+					if (RoomVisitedBy[*NextIndex] != Source)
+					{
+						RoomVisitedBy[*NextIndex] = Source;
+						OutTable.RoomIndices.Add(*NextIndex);
+					}
+
+					const int32 State = DoorOffsets[*NextIndex] + NextDoor;
+					if (DoorVisitedBy[State] == Source)
+						continue;
+
+					DoorVisitedBy[State] = Source;
+					Queue.Emplace(*NextIndex, NextDoor);
+				}
+			}
+			Begin = End;
+		}
+	}
+	OutTable.Offsets.Add(OutTable.RoomIndices.Num());
+
+	return bIsComplete;
+}
+
+bool UDungeonGraph::HasDoorVisibility() const
+{
+	if (bIsDoorVisibilityCached)
+		return bHasDoorVisibility;
+
+	bool bIsComplete = true;
+	bool bHasVisibility = false;
+	for (const URoom* Room : Rooms)
+	{
+		const URoomData* Data = IsValid(Room) ? Room->GetRoomData() : nullptr;
+		if (!IsValid(Data))
+		{
+			bIsComplete = false;
+			continue;
+		}
+
+		if (Data->HasDoorVisibility())
+		{
+			bHasVisibility = true;
+			break;
+		}
+	}
+
+	// Kept only once all the room data are replicated, since a missing one may have a door visibility.
+	if (bHasVisibility || bIsComplete)
+	{
+		bIsDoorVisibilityCached = true;
+		bHasDoorVisibility = bHasVisibility;
+	}
+	return bHasVisibility;
+}
+
 // Do one cycle of BFS (dequeue one room from Queue, then check all its connections to add them in MarkedThis and filling ParentMap)
 // Fills OutCommon  if a connection has been found in MarkedOther
 // Returns true if OutCommon had been filled
@@ -637,50 +1138,61 @@ void UDungeonGraph::SynchronizeRooms()
 		RebuildBounds();
 	}
 
-	bIsDirty = false;
-}
+	InvalidateRoomDistances();
 
-bool UDungeonGraph::AreRoomsLoaded(int32& NbRoomLoaded) const
-{
-	NbRoomLoaded = 0;
-	for (URoom* Room : Rooms)
+	// The remaining rooms will be removed from this set when their data is replicated.
+	PendingReadyRooms.Reset();
+	for (const URoom* Room : Rooms)
 	{
-		if (Room->IsInstanceLoaded())
-			NbRoomLoaded++;
+		if (!(IsValid(Room) && Room->IsReady()))
+			PendingReadyRooms.Add(Room);
 	}
-	return NbRoomLoaded >= Rooms.Num();
+
+	bIsDirty = false;
 }
 
 bool UDungeonGraph::AreRoomsUnloaded(int32& NbRoomUnloaded) const
 {
-	NbRoomUnloaded = 0;
-	for (URoom* Room : Rooms)
-	{
-		if (!IsValid(Room) || Room->IsInstanceUnloaded())
-			NbRoomUnloaded++;
-	}
-	return NbRoomUnloaded >= Rooms.Num();
+	NbRoomUnloaded = UnloadingRooms.Num() - PendingUnloadRooms.Num();
+	return PendingUnloadRooms.Num() <= 0;
 }
 
-bool UDungeonGraph::AreRoomsInitialized(int32& NbRoomInitialized) const
+bool UDungeonGraph::AreNearRoomsInitialized(int32 MaxDistance, int32& NbRoomInitialized, int32& NbRoomToInitialize) const
 {
-	NbRoomInitialized = 0;
-	for (URoom* Room : Rooms)
-	{
-		if (Room->IsInstanceInitialized())
-			NbRoomInitialized++;
-	}
-	return NbRoomInitialized >= Rooms.Num();
+	// Both arrays are sorted by distance
+	NbRoomToInitialize = Algo::UpperBound(LoadQueueDistances, MaxDistance);
+	NbRoomInitialized = Algo::UpperBound(InitializedDistances, MaxDistance);
+	return NbRoomInitialized >= NbRoomToInitialize;
 }
 
 bool UDungeonGraph::AreRoomsReady() const
 {
-	for (URoom* Room : Rooms)
-	{
-		if (!(IsValid(Room) && Room->IsReady()))
-			return false;
-	}
-	return true;
+	return PendingReadyRooms.Num() <= 0;
+}
+
+void UDungeonGraph::OnRoomReady(const URoom* Room)
+{
+	PendingReadyRooms.Remove(Room);
+}
+
+void UDungeonGraph::OnRoomLoaded(const URoom* Room)
+{
+	LoadingRooms.Remove(Room);
+}
+
+void UDungeonGraph::OnRoomInitialized(const URoom* Room)
+{
+	int32 Distance = 0;
+	if (PendingInitRooms.RemoveAndCopyValue(Room, Distance))
+		InitializedDistances.Insert(Distance, Algo::UpperBound(InitializedDistances, Distance));
+}
+
+void UDungeonGraph::OnRoomUnloaded(const URoom* Room)
+{
+	PendingUnloadRooms.Remove(Room);
+
+	// The level may be unloaded before the end of its loading.
+	LoadingRooms.Remove(Room);
 }
 
 void UDungeonGraph::SpawnAllDoors()
@@ -702,13 +1214,201 @@ void UDungeonGraph::SpawnAllDoors()
 
 void UDungeonGraph::LoadAllRooms()
 {
-	// When a level is correct, load all rooms
+	LoadAllRooms(TSet<URoom*>());
+	UpdateDoorSpawning(/*MaxSpawnedDoors = */ 0);
+	UpdateRoomLoading(/*MaxLoadingRooms = */ 0);
+}
+
+void UDungeonGraph::LoadAllRooms(const TSet<URoom*>& StartRooms, int32 MaxDistance)
+{
+	LoadQueue.Reset();
+	LoadQueueDistances.Reset();
+	LoadQueueIndex = 0;
+	QueuedRooms.Reset();
+	PendingInitRooms.Reset();
+	InitializedDistances.Reset();
+	DoorQueue.Reset();
+	DoorQueueDistances.Reset();
+	DoorQueueIndex = 0;
+
+	// Breadth first traversal from the start rooms (or the first room by default)
+	TSet<URoom*> Visited;
+	TArray<URoom*> Ordered;
+	TArray<int32> Distances;
+	for (URoom* Room : StartRooms)
+	{
+		if (IsValid(Room) && Rooms.Contains(Room))
+		{
+			Visited.Add(Room);
+			Ordered.Add(Room);
+			Distances.Add(0);
+		}
+	}
+
+	if (Ordered.Num() <= 0 && Rooms.Num() > 0)
+	{
+		Visited.Add(Rooms[0]);
+		Ordered.Add(Rooms[0]);
+		Distances.Add(0);
+	}
+
+	for (int32 n = 0; n < Ordered.Num(); ++n)
+	{
+		const URoom* Current = Ordered[n];
+		for (int32 i = 0; i < Current->GetConnectionCount(); ++i)
+		{
+			URoom* Next = Current->GetConnectedRoom(i).Get();
+			if (!IsValid(Next) || Visited.Contains(Next))
+				continue;
+
+			Visited.Add(Next);
+			Ordered.Add(Next);
+			Distances.Add(Distances[n] + 1);
+		}
+	}
+
+	// Rooms not reachable from the start rooms are loaded last
 	for (URoom* Room : Rooms)
 	{
+		if (!Visited.Contains(Room))
+		{
+			Ordered.Add(Room);
+			Distances.Add(MAX_int32);
+		}
+	}
+
+	// Rooms kept from an incremental update are already loaded.
+	// They are still queued if not initialized yet, so they are waited for, but they won't be instantiated again.
+	for (int32 i = 0; i < Ordered.Num(); ++i)
+	{
+		if (Ordered[i]->Instance != nullptr && Ordered[i]->IsInstanceInitialized())
+			continue;
+
+		// Rooms too far will be streamed in later by the generator
+		if (MaxDistance >= 0 && Distances[i] > MaxDistance)
+			continue;
+
+		LoadQueue.Add(Ordered[i]);
+		LoadQueueDistances.Add(Distances[i]);
+		QueuedRooms.Add(Ordered[i]);
+		PendingInitRooms.Add(Ordered[i], Distances[i]);
+	}
+
+	DungeonLog_Debug("Queued %d rooms to load.", LoadQueue.Num());
+
+	// Spawn doors only on server
+	// They will be replicated on the clients
+	if (!HasAuthority())
+		return;
+
+	// The doors take the distance of their nearest room
+	TSet<const URoomConnection*> QueuedConnections;
+	for (int32 i = 0; i < Ordered.Num(); ++i)
+	{
+		for (int32 Door = 0; Door < Ordered[i]->GetConnectionCount(); ++Door)
+		{
+			URoomConnection* Connection = Ordered[i]->GetConnection(Door);
+			if (!IsValid(Connection) || Connection->IsDoorInstanced())
+				continue;
+
+			bool bAlreadyQueued = false;
+			QueuedConnections.Add(Connection, &bAlreadyQueued);
+			if (bAlreadyQueued)
+				continue;
+
+			DoorQueue.Add(Connection);
+			DoorQueueDistances.Add(Distances[i]);
+		}
+	}
+
+	DungeonLog_Debug("Queued %d doors to spawn.", DoorQueue.Num());
+}
+
+void UDungeonGraph::UpdateDoorSpawning(int32 MaxSpawnedDoors)
+{
+	if (!HasDoorsToSpawn())
+		return;
+
+	checkf(Generator.IsValid(), TEXT("Spawning dungeon's doors is only available with a ADungeonGenerator outer."));
+
+	int32 NbSpawnedDoors = 0;
+	while (HasDoorsToSpawn() && (MaxSpawnedDoors <= 0 || NbSpawnedDoors < MaxSpawnedDoors))
+	{
+		URoomConnection* Connection = DoorQueue[DoorQueueIndex++];
+		if (!IsValid(Connection) || Connection->IsDoorInstanced())
+			continue;
+
+		Connection->InstantiateDoor(GetWorld(), Generator.Get(), Generator->UseGeneratorTransform());
+		NbSpawnedDoors++;
+	}
+}
+
+bool UDungeonGraph::AreNearDoorsSpawned(int32 MaxDistance, int32& NbDoorSpawned, int32& NbDoorToSpawn) const
+{
+	// The queue is sorted by distance and spawned in order.
+	NbDoorToSpawn = Algo::UpperBound(DoorQueueDistances, MaxDistance);
+	NbDoorSpawned = FMath::Min(DoorQueueIndex, NbDoorToSpawn);
+	return NbDoorSpawned >= NbDoorToSpawn;
+}
+
+void UDungeonGraph::UpdateRoomLoading(int32 MaxLoadingRooms)
+{
+	if (!HasRoomsToLoad())
+		return;
+
+	while (HasRoomsToLoad() && (MaxLoadingRooms <= 0 || LoadingRooms.Num() < MaxLoadingRooms))
+	{
+		URoom* Room = LoadQueue[LoadQueueIndex++];
+		if (!IsValid(Room) || QueuedRooms.Remove(Room) <= 0 || Room->Instance != nullptr)
+			continue;
+
+		// Added before instantiating, since a pooled level instance is loaded right away.
+		LoadingRooms.Add(Room);
 		Room->Instantiate(GetWorld());
+		if (!IsValid(Room->Instance))
+			LoadingRooms.Remove(Room);
 	}
+}
 
-	SpawnAllDoors();
+void UDungeonGraph::QueueRoomLoad(URoom* Room)
+{
+	check(IsValid(Room));
+	bool bIsAlreadyQueued = false;
+	QueuedRooms.Add(Room, &bIsAlreadyQueued);
+	if (bIsAlreadyQueued)
+		return;
+
+	// Drops the rooms already processed, so the queue does not grow with each streamed room.
+	if (!HasRoomsToLoad() && PendingInitRooms.Num() <= 0)
+	{
+		LoadQueue.Reset();
+		LoadQueueDistances.Reset();
+		LoadQueueIndex = 0;
+		InitializedDistances.Reset();
+	}
+
+	// Queued after all the others, so the distances stay sorted.
+	LoadQueue.Add(Room);
+	LoadQueueDistances.Add(MAX_int32);
+	PendingInitRooms.Add(Room, MAX_int32);
+}
+
+void UDungeonGraph::CancelRoomLoad(const URoom* Room)
+{
+	if (QueuedRooms.Remove(Room) <= 0)
+		return;
+
+	// Counted as initialized, so it is not waited for by AreNearRoomsInitialized.
+	OnRoomInitialized(Room);
+}
+
+void UDungeonGraph::DestroyDoor(ADoor* Door) const
+{
+	// The generator may keep the door to reuse it in a next dungeon
+	if (Generator.IsValid() && Generator->ReleaseDoor(Door))
+		return;
+
+	Door->Destroy();
 }
 
 void UDungeonGraph::UnloadAllRooms()
@@ -720,16 +1420,72 @@ void UDungeonGraph::UnloadAllRooms()
 			ADoor* Door = RoomConnection->GetDoorInstance();
 			if (IsValid(Door))
 			{
-				Door->Destroy();
+				DestroyDoor(Door);
 			}
 		}
 	}
 
-	for (URoom* Room : Rooms)
+	LoadQueue.Reset();
+	LoadQueueDistances.Reset();
+	LoadQueueIndex = 0;
+	QueuedRooms.Reset();
+	LoadingRooms.Reset();
+	PendingInitRooms.Reset();
+	InitializedDistances.Reset();
+	DoorQueue.Reset();
+	DoorQueueDistances.Reset();
+	DoorQueueIndex = 0;
+
+	UnloadingRooms = TArray<URoom*>(Rooms);
+	UnloadingRooms.Append(RemovedRooms);
+	RemovedRooms.Reset();
+	DestroyUnloadingRooms();
+}
+
+void UDungeonGraph::UnloadRemovedRooms()
+{
+	UnloadingRooms.Reset();
+	if (HasAuthority())
+	{
+		Swap(UnloadingRooms, RemovedRooms);
+	}
+	else
+	{
+		const TSet<URoom*> KeptRooms(ReplicatedRooms);
+		for (URoom* Room : Rooms)
+		{
+			if (!KeptRooms.Contains(Room))
+				UnloadingRooms.Add(Room);
+		}
+	}
+
+	DestroyUnloadingRooms();
+}
+
+void UDungeonGraph::DestroyUnloadingRooms()
+{
+	PendingUnloadRooms.Reset();
+	for (URoom* Room : UnloadingRooms)
 	{
 		check(Room);
 		Room->Destroy();
+
+		// Only the loaded levels notify when they are unloaded.
+		// The pooled ones and the ones still loading are considered unloaded right away.
+		if (Room->IsInstanceLoaded())
+			PendingUnloadRooms.Add(Room);
+	}
+}
+
+bool UDungeonGraph::IsIncrementalUpdate() const
+{
+	const TSet<URoom*> KeptRooms(ReplicatedRooms);
+	for (URoom* Room : Rooms)
+	{
+		if (KeptRooms.Contains(Room))
+			return true;
 	}
+	return false;
 }
 
 void UDungeonGraph::UpdateBounds(const URoom* Room)
@@ -740,6 +1496,9 @@ void UDungeonGraph::UpdateBounds(const URoom* Room)
 
 void UDungeonGraph::RebuildBounds()
 {
+	// The rooms may have moved, the occupied cells must be computed again.
+	RoomCells.Empty();
+
 	Bounds = FVoxelBounds();
 	for (const URoom* Room : Rooms)
 	{
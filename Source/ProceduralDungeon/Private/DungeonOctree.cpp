@@ -13,3 +13,9 @@ FDungeonOctreeElement::FDungeonOctreeElement(URoom* Room)
 	this->Room = Room;
 	Bounds = Room->GetBounds();
 }
+
+void FDungeonOctreeSemantics::SetElementId(const FDungeonOctreeElement& Element, FDungeonOctreeElementId Id)
+{
+	check(Element.Room);
+	Element.Room->OctreeElementId = Id;
+}
@@ -0,0 +1,306 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#include "InfiniteDungeonGenerator.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "DungeonGraph.h"
+#include "Room.h"
+#include "RoomData.h"
+#include "ProceduralDungeonUtils.h"
+#include "ProceduralDungeonLog.h"
+
+namespace
+{
+	// Integer division rounded toward negative infinity.
+	int32 FloorDiv(int32 A, int32 B)
+	{
+		return (A >= 0) ? A / B : (A - B + 1) / B;
+	}
+} //namespace
+
+AInfiniteDungeonGenerator::AInfiniteDungeonGenerator()
+	: Super()
+{
+	// Breadth first spreads the rooms in the whole region instead of making long corridors across it.
+	GenerationType = EGenerationType::BFS;
+}
+
+void AInfiniteDungeonGenerator::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceRegionUpdate += DeltaTime;
+	if (TimeSinceRegionUpdate < RegionUpdateInterval)
+		return;
+
+	TimeSinceRegionUpdate = 0.0f;
+	UpdateRegions();
+}
+
+bool AInfiniteDungeonGenerator::CreateDungeon_Implementation()
+{
+	// Only server generate the dungeon
+	// DungeonGraph will be replicated to all clients
+	if (!HasAuthority())
+		return false;
+
+	// Only the first room is validated by IsValidDungeon, the regions generated later are always kept.
+	int TriesLeft = Dungeon::MaxGenerationTryBeforeGivingUp();
+	bool ValidDungeon = false;
+	URoom* root = nullptr;
+	do
+	{
+		TriesLeft--;
+
+		StartNewDungeon();
+		GeneratedRegions.Empty();
+		EmptyRegions.Empty();
+
+		URoomData* def = ChooseFirstRoomData();
+		if (!IsValid(def))
+		{
+			DungeonLog_Error("ChooseFirstRoomData returned null.");
+			continue;
+		}
+
+		// Create the first room
+		root = CreateRoomInstance(def);
+		AddRoomToDungeon(root, /*DoorsToConnect = */ {}, /*bFailIfNotConnected = */ false);
+		FinalizeDungeon();
+
+		ValidDungeon = IsValidDungeon();
+	} while (TriesLeft > 0 && !ValidDungeon);
+
+	if (!ValidDungeon)
+	{
+		DungeonLog_Error("Generated dungeon is not valid after %d tries. Make sure your ChooseFirstRoomData and IsValidDungeon functions are correct.", Dungeon::MaxGenerationTryBeforeGivingUp());
+		return false;
+	}
+
+	// Then generate the regions around the first room and the players
+	TSet<FIntVector> CenterRegions;
+	GetPlayerRegions(CenterRegions);
+	CenterRegions.Add(GetRegionAt(root->Position));
+	GatherPendingRegions(CenterRegions);
+
+	return ExpandDungeon();
+}
+
+bool AInfiniteDungeonGenerator::ExpandDungeon_Implementation()
+{
+	// A regenerated branch is limited to the region in front of its freed door.
+	URoom* BranchRoot = nullptr;
+	int32 BranchDoor = -1;
+	if (GetBranchToRegenerate(BranchRoot, BranchDoor))
+	{
+		ExpandingRegion = GetRegionAt(BranchRoot->GetDoorDef(BranchDoor).GetOpposite().Position);
+		bIsExpandingRegion = true;
+		const bool bBranchSuccess = Super::ExpandDungeon_Implementation();
+		bIsExpandingRegion = false;
+		return bBranchSuccess;
+	}
+
+	// A region may be reached only by the doors of a region expanded after it (e.g. a diagonal region),
+	// so the regions are expanded again until a whole pass places no room.
+	bool bSuccess = true;
+	TSet<FIntVector> FilledRegions;
+	bool bHasAddedRooms = true;
+	for (int32 Pass = 0; bHasAddedRooms; ++Pass)
+	{
+		bHasAddedRooms = false;
+		for (const FIntVector& Region : PendingRegions)
+		{
+			// Each region uses its own seed, so its content depends only on the doors leading into it when it is generated.
+			InitializeRandomStream(GetRegionSeed(Region) + Pass);
+			ExpandingRegion = Region;
+			bIsExpandingRegion = true;
+			const int32 RoomCount = Graph->Count();
+			bSuccess &= Super::ExpandDungeon_Implementation();
+			if (Graph->Count() > RoomCount)
+			{
+				FilledRegions.Add(Region);
+				bHasAddedRooms = true;
+			}
+		}
+	}
+
+	// The regions no door leads into yet are tried again the next time the dungeon grows.
+	for (const FIntVector& Region : PendingRegions)
+	{
+		if (FilledRegions.Contains(Region))
+		{
+			GeneratedRegions.Add(Region);
+			EmptyRegions.Remove(Region);
+			DungeonLog_Debug("Generated region (%s)", *Region.ToString());
+		}
+		else
+		{
+			EmptyRegions.Add(Region);
+		}
+	}
+
+	bIsExpandingRegion = false;
+	PendingRegions.Empty();
+	return bSuccess;
+}
+
+bool AInfiniteDungeonGenerator::ContinueToAddRoom_Implementation()
+{
+	// The generation is limited by the regions.
+	return true;
+}
+
+bool AInfiniteDungeonGenerator::CanExpandDoor(const URoom& Room, int32 DoorIndex) const
+{
+	if (!bIsExpandingRegion)
+		return false;
+
+	const FDoorDef NewRoomDoor = Room.GetDoorDef(DoorIndex).GetOpposite();
+	return GetRegionAt(NewRoomDoor.Position) == ExpandingRegion;
+}
+
+FIntVector AInfiniteDungeonGenerator::GetRegionAt(FIntVector RoomCell) const
+{
+	const FIntVector Size(FMath::Max(1, RegionSize.X), FMath::Max(1, RegionSize.Y), FMath::Max(1, RegionSize.Z));
+	return FIntVector(FloorDiv(RoomCell.X, Size.X), FloorDiv(RoomCell.Y, Size.Y), FloorDiv(RoomCell.Z, Size.Z));
+}
+
+int32 AInfiniteDungeonGenerator::GetRegionSeed(FIntVector Region) const
+{
+	const int64 Salt = (static_cast<int64>(static_cast<uint32>(GetSeed())) << 32) | GetTypeHash(Region);
+	return static_cast<int32>(Random::Guid2Seed(GetGuid(), Salt));
+}
+
+void AInfiniteDungeonGenerator::UpdateRegions()
+{
+	// Only server generate the dungeon
+	if (!HasAuthority())
+		return;
+
+	// Wait for the first generation, and don't interrupt the current one.
+	if (GetCurrentState() != EGenerationState::Idle || IsGenerating() || !Graph->HasRooms())
+		return;
+
+	TSet<FIntVector> PlayerRegions;
+	GetPlayerRegions(PlayerRegions);
+	if (PlayerRegions.Num() <= 0)
+		return;
+
+	// Forget the far regions
+	TArray<URoom*> FarRooms;
+	for (URoom* Room : Graph->GetAllRooms())
+	{
+		check(IsValid(Room));
+		if (GetRegionDistance(GetRegionAt(Room->Position), PlayerRegions) > UnloadDistance)
+			FarRooms.Add(Room);
+	}
+
+	for (auto It = GeneratedRegions.CreateIterator(); It; ++It)
+	{
+		if (GetRegionDistance(*It, PlayerRegions) > UnloadDistance)
+			It.RemoveCurrent();
+	}
+
+	for (auto It = EmptyRegions.CreateIterator(); It; ++It)
+	{
+		if (GetRegionDistance(*It, PlayerRegions) > UnloadDistance)
+			It.RemoveCurrent();
+	}
+
+	// Keep at least some rooms to grow the dungeon from.
+	if (FarRooms.Num() >= Graph->Count())
+	{
+		DungeonLog_WarningSilent("All the rooms are too far from the players, they will not be unloaded.");
+		FarRooms.Empty();
+	}
+
+	if (FarRooms.Num() > 0)
+	{
+		DungeonLog_Info("Unloading %d rooms from the far regions.", FarRooms.Num());
+		Graph->RemoveRooms(FarRooms);
+	}
+
+	GatherPendingRegions(PlayerRegions);
+
+	// The empty regions are expanded again with the others, but they don't trigger a new growth alone.
+	bool bHasNewRegions = false;
+	for (const FIntVector& Region : PendingRegions)
+	{
+		if (!EmptyRegions.Contains(Region))
+		{
+			bHasNewRegions = true;
+			break;
+		}
+	}
+
+	if (FarRooms.Num() > 0 || bHasNewRegions)
+		Grow();
+}
+
+void AInfiniteDungeonGenerator::GetPlayerRegions(TSet<FIntVector>& OutRegions) const
+{
+	OutRegions.Empty();
+
+	const FTransform& DungeonTransform = GetDungeonTransform();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		const APawn* Pawn = IsValid(Controller) ? Controller->GetPawnOrSpectator() : nullptr;
+		if (!IsValid(Pawn))
+			continue;
+
+		const FVector LocalLocation = DungeonTransform.InverseTransformPositionNoScale(Pawn->GetActorLocation());
+		OutRegions.Add(GetRegionAt(Dungeon::ToRoomLocation(LocalLocation)));
+	}
+}
+
+void AInfiniteDungeonGenerator::GatherPendingRegions(const TSet<FIntVector>& CenterRegions)
+{
+	PendingRegions.Empty();
+	for (const FIntVector& Center : CenterRegions)
+	{
+		for (int32 X = -LoadDistance; X <= LoadDistance; ++X)
+		{
+			for (int32 Y = -LoadDistance; Y <= LoadDistance; ++Y)
+			{
+				for (int32 Z = -LoadDistance; Z <= LoadDistance; ++Z)
+				{
+					const FIntVector Region = Center + FIntVector(X, Y, Z);
+					if (!GeneratedRegions.Contains(Region))
+						PendingRegions.AddUnique(Region);
+				}
+			}
+		}
+	}
+
+	// Generate the nearest regions first, then use a fixed order for the determinism.
+	PendingRegions.Sort([&CenterRegions](const FIntVector& A, const FIntVector& B) {
+		const int32 DistanceA = GetRegionDistance(A, CenterRegions);
+		const int32 DistanceB = GetRegionDistance(B, CenterRegions);
+		if (DistanceA != DistanceB)
+			return DistanceA < DistanceB;
+		if (A.Z != B.Z)
+			return A.Z < B.Z;
+		if (A.Y != B.Y)
+			return A.Y < B.Y;
+		return A.X < B.X;
+	});
+}
+
+int32 AInfiniteDungeonGenerator::GetRegionDistance(const FIntVector& Region, const TSet<FIntVector>& CenterRegions)
+{
+	int32 MinDistance = MAX_int32;
+	for (const FIntVector& Center : CenterRegions)
+	{
+		const FIntVector Delta = Region - Center;
+		const int32 Distance = FMath::Max3(FMath::Abs(Delta.X), FMath::Abs(Delta.Y), FMath::Abs(Delta.Z));
+		MinDistance = FMath::Min(MinDistance, Distance);
+	}
+	return MinDistance;
+}
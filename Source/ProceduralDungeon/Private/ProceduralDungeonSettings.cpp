@@ -19,11 +19,15 @@ UProceduralDungeonSettings::UProceduralDungeonSettings(const FObjectInitializer&
 	MaxGenerationTry = 500;
 	MaxRoomPlacementTry = 10;
 	RoomLimit = 100;
+	RoomVisitorUpdateInterval = 0.1f;
 
 	// Occlusion settings
 	OcclusionCulling = true;
 	//LegacyOcclusion = true;
 	OcclusionDistance = 2;
+	OcclusionProxyDistance = 0;
+	PortalOcclusion = false;
+	ClosedDoorsOcclude = true;
 	OccludeDynamicActors = true;
 
 	// Debug settings
@@ -38,6 +42,12 @@ UProceduralDungeonSettings::UProceduralDungeonSettings(const FObjectInitializer&
 
 	// Register console variables.
 
+	IConsoleManager::Get().RegisterConsoleVariableRef(TEXT("pd.Visitors.UpdateInterval")
+		, RoomVisitorUpdateInterval
+		, TEXT("Change the time (in seconds) between two updates of the rooms of the actors registered in the Room Visitor Subsystem.")
+		, EConsoleVariableFlags::ECVF_Cheat
+	);
+
 	IConsoleManager::Get().RegisterConsoleVariableRef(TEXT("pd.Occlusion")
 		, OcclusionCulling
 		, TEXT("Enable/disable the plugin's occlusion culling system.")
@@ -51,6 +61,25 @@ UProceduralDungeonSettings::UProceduralDungeonSettings(const FObjectInitializer&
 		, EConsoleVariableFlags::ECVF_Cheat
 	);
 
+	IConsoleManager::Get().RegisterConsoleVariableRef(TEXT("pd.Occlusion.ProxyDistance")
+		, OcclusionProxyDistance
+		, TEXT("Change the number of rooms beyond the occlusion distance showing their proxy mesh.\n")
+		  TEXT("0 or negative means no proxy mesh shown.")
+		, EConsoleVariableFlags::ECVF_Cheat
+	);
+
+	IConsoleManager::Get().RegisterConsoleVariableRef(TEXT("pd.Occlusion.Portals")
+		, PortalOcclusion
+		, TEXT("Enable/disable the use of the doors as portals to find the rooms seen by the player's camera.")
+		, EConsoleVariableFlags::ECVF_Cheat
+	);
+
+	IConsoleManager::Get().RegisterConsoleVariableRef(TEXT("pd.Occlusion.Portals.ClosedDoors")
+		, ClosedDoorsOcclude
+		, TEXT("Enable/disable the closed doors hiding the rooms behind them when the portal occlusion is enabled.")
+		, EConsoleVariableFlags::ECVF_Cheat
+	);
+
 	IConsoleManager::Get().RegisterConsoleVariableRef(TEXT("pd.Occlusion.DynamicActors")
 		, OccludeDynamicActors
 		, TEXT("Enable/disable the occlusion of actors with a RoomVisibility component attached on them.")
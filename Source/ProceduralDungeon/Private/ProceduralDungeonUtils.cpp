@@ -118,6 +118,24 @@ uint32 Dungeon::OcclusionDistance()
 	return Settings->OcclusionDistance;
 }
 
+uint32 Dungeon::OcclusionProxyDistance()
+{
+	const UProceduralDungeonSettings* Settings = GetDefault<UProceduralDungeonSettings>();
+	return FMath::Max(0, Settings->OcclusionProxyDistance);
+}
+
+bool Dungeon::PortalOcclusion()
+{
+	const UProceduralDungeonSettings* Settings = GetDefault<UProceduralDungeonSettings>();
+	return Settings->PortalOcclusion;
+}
+
+bool Dungeon::ClosedDoorsOcclude()
+{
+	const UProceduralDungeonSettings* Settings = GetDefault<UProceduralDungeonSettings>();
+	return Settings->ClosedDoorsOcclude;
+}
+
 bool Dungeon::OccludeDynamicActors()
 {
 	const UProceduralDungeonSettings* Settings = GetDefault<UProceduralDungeonSettings>();
@@ -190,6 +208,18 @@ int32 Dungeon::RoomLimit()
 	return Settings->RoomLimit;
 }
 
+EUnloadGarbageCollection Dungeon::UnloadGarbageCollection()
+{
+	const UProceduralDungeonSettings* Settings = GetDefault<UProceduralDungeonSettings>();
+	return Settings->UnloadGarbageCollection;
+}
+
+float Dungeon::RoomVisitorUpdateInterval()
+{
+	const UProceduralDungeonSettings* Settings = GetDefault<UProceduralDungeonSettings>();
+	return FMath::Max(0.01f, Settings->RoomVisitorUpdateInterval);
+}
+
 void Dungeon::EnableOcclusionCulling(bool Enable)
 {
 	UProceduralDungeonSettings* Settings = GetMutableDefault<UProceduralDungeonSettings>();
@@ -97,6 +97,19 @@ void URoom::SetConnection(int32 DoorIndex, URoomConnection* Conn)
 	MARK_PROPERTY_DIRTY_FROM_NAME(URoom, Connections, this);
 }
 
+void URoom::ClearConnection(int32 DoorIndex)
+{
+	check(Connections.IsValidIndex(DoorIndex));
+	Connections[DoorIndex] = nullptr;
+	MARK_PROPERTY_DIRTY_FROM_NAME(URoom, Connections, this);
+}
+
+URoomConnection* URoom::GetConnection(int32 DoorIndex) const
+{
+	check(Connections.IsValidIndex(DoorIndex));
+	return Connections[DoorIndex].Get();
+}
+
 TWeakObjectPtr<URoom> URoom::GetConnectedRoom(int32 DoorIndex) const
 {
 	check(Connections.IsValidIndex(DoorIndex));
@@ -137,7 +150,7 @@ void URoom::Instantiate(UWorld* World)
 			return;
 		}
 
-		const TSoftObjectPtr<UWorld>& Level = RoomData->Level;
+		const TSoftObjectPtr<UWorld>& Level = RoomData->GetLevelToLoad(World);
 		if (Level.IsNull())
 		{
 			DungeonLog_Error("Failed to instantiate the room: Level asset is invalid in room data.");
@@ -148,7 +161,8 @@ void URoom::Instantiate(UWorld* World)
 		FQuat rotation = FQuat::Identity;
 		TStringBuilder<256> InstanceName;
 
-		InstanceName.Append(Level.GetAssetName());
+		// Always named after the client level, so the room instances have the same package path on the server and the clients.
+		InstanceName.Append(RoomData->Level.GetAssetName());
 		if (GeneratorOwner.IsValid())
 		{
 			offset = GeneratorOwner->GetDungeonOffset();
@@ -159,6 +173,19 @@ void URoom::Instantiate(UWorld* World)
 
 		FVector FinalLocation = rotation.RotateVector(Dungeon::RoomUnit() * FVector(Position)) + offset;
 		FQuat FinalRotation = rotation * ToQuaternion(Direction);
+
+		// Reuse a level instance of a previous dungeon if available
+		if (GeneratorOwner.IsValid())
+		{
+			Instance = GeneratorOwner->AcquireLevelInstance(Level, FTransform(FinalRotation, FinalLocation));
+			if (IsValid(Instance))
+			{
+				DungeonLog_Info("[%s][R:%s][I:%s] Reuse room Instance: %s", *GetAuthorityName(), *GetName(), *GetNameSafe(Instance), *Instance->GetWorldAssetPackageName());
+				OnInstanceLoaded();
+				return;
+			}
+		}
+
 		Instance = LoadInstance(World, Level, InstanceName.ToString(), FinalLocation, FinalRotation.Rotator());
 
 		if (!IsValid(Instance))
@@ -178,9 +205,15 @@ void URoom::Instantiate(UWorld* World)
 
 void URoom::Destroy()
 {
-	if (IsValid(Instance))
+	if (IsValid(Instance) && GeneratorOwner.IsValid() && RoomData.IsValid() && GeneratorOwner->ReleaseLevelInstance(RoomData->GetLevelToLoad(Instance->GetWorld()), Instance))
+	{
+		DungeonLog_InfoSilent("[%s][R:%s][I:%s] Pool room Instance: %s", *GetAuthorityName(), *GetName(), *GetNameSafe(Instance), *Instance->GetWorldAssetPackageName());
+		Instance = nullptr;
+	}
+	else if (IsValid(Instance))
 	{
 		DungeonLog_InfoSilent("[%s][R:%s][I:%s] Unload room Instance: %s", *GetAuthorityName(), *GetName(), *GetNameSafe(Instance), *Instance->GetWorldAssetPackageName());
+		Instance->OnLevelUnloaded.AddUniqueDynamic(this, &URoom::OnInstanceUnloaded);
 		UnloadInstance(Instance);
 	}
 	else
@@ -189,11 +222,48 @@ void URoom::Destroy()
 	}
 }
 
+void URoom::StreamOut()
+{
+	if (!IsInstanceInitialized())
+	{
+		DungeonLog_Error("Failed to stream out the room: its instance is not initialized.");
+		return;
+	}
+
+	DispatchCallbackToSavedLevelActors(&IDungeonSaveInterface::DispatchPreSaveEvent);
+
+	StreamingData = MakeUnique<FSaveData>();
+	SerializeLevelActors(*StreamingData, false);
+
+	// Not using Destroy here, the level must be unloaded and not pooled.
+	DungeonLog_InfoSilent("[%s][R:%s][I:%s] Stream out room Instance: %s", *GetAuthorityName(), *GetName(), *GetNameSafe(Instance), *Instance->GetWorldAssetPackageName());
+	UnloadInstance(Instance);
+	Instance = nullptr;
+}
+
+void URoom::OnInstanceInitialized()
+{
+	if (GeneratorOwner.IsValid())
+		GeneratorOwner->NotifyRoomInitialized(this);
+
+	if (!StreamingData.IsValid())
+		return;
+
+	DungeonLog_Debug("[%s][R:%s] Restoring streamed out actors.", *GetAuthorityName(), *GetName());
+	SerializeLevelActors(*StreamingData, true);
+	StreamingData.Reset();
+
+	DispatchCallbackToSavedLevelActors(&IDungeonSaveInterface::DispatchPostLoadEvent);
+}
+
 void URoom::OnInstanceLoaded()
 {
 	check(IsValid(Instance));
 	Instance->OnLevelLoaded.RemoveDynamic(this, &URoom::OnInstanceLoaded);
 
+	if (GeneratorOwner.IsValid())
+		GeneratorOwner->NotifyRoomLoaded(this);
+
 	ARoomLevel* Script = GetLevelScript();
 	if (!IsValid(Script))
 	{
@@ -214,6 +284,17 @@ void URoom::OnInstanceLoaded()
 	DungeonLog_InfoSilent("[%s][R:%s][I:%s] Room loaded: %s", *GetAuthorityName(), *GetName(), *GetNameSafe(Instance), *Instance->GetWorldAssetPackageName());
 }
 
+void URoom::OnInstanceUnloaded()
+{
+	check(IsValid(Instance));
+	Instance->OnLevelUnloaded.RemoveDynamic(this, &URoom::OnInstanceUnloaded);
+
+	DungeonLog_InfoSilent("[%s][R:%s][I:%s] Room unloaded: %s", *GetAuthorityName(), *GetName(), *GetNameSafe(Instance), *Instance->GetWorldAssetPackageName());
+
+	if (GeneratorOwner.IsValid())
+		GeneratorOwner->NotifyRoomUnloaded(this);
+}
+
 void URoom::ForceVisibility(bool bForce)
 {
 	const bool bWasVisible = IsVisible();
@@ -226,6 +307,7 @@ void URoom::Lock(bool bLock)
 {
 	SET_SUBOBJECT_REPLICATED_PROPERTY_VALUE(bIsLocked, bLock);
 	DungeonLog_Debug("[%s] Room '%s' setting IsLocked: %s", *GetAuthorityName(), *GetNameSafe(this), bIsLocked ? TEXT("True") : TEXT("False"));
+	UpdateDoors();
 }
 
 void URoom::SetPosition(const FIntVector& NewPosition)
@@ -241,6 +323,7 @@ void URoom::SetDirection(EDoorDirection NewDirection)
 void URoom::UpdateVisibility() const
 {
 	const bool bNewVisibility = IsVisible();
+	UpdateDoors();
 
 	if (Dungeon::UseLegacyOcclusion())
 	{
@@ -262,6 +345,17 @@ void URoom::UpdateVisibility() const
 void URoom::OnRep_IsLocked()
 {
 	DungeonLog_Debug("[%s] Room '%s' IsLocked Replicated: %s", *GetAuthorityName(), *GetNameSafe(this), bIsLocked ? TEXT("True") : TEXT("False"));
+	UpdateDoors();
+}
+
+void URoom::UpdateDoors() const
+{
+	for (const auto& Connection : Connections)
+	{
+		ADoor* Door = URoomConnection::GetDoorInstance(Connection.Get());
+		if (IsValid(Door))
+			Door->UpdateDoorState();
+	}
 }
 
 void URoom::OnRep_Id()
@@ -272,6 +366,11 @@ void URoom::OnRep_Id()
 void URoom::OnRep_RoomData()
 {
 	DungeonLog_Debug("[%s] Room '%s' RoomData Replicated: %s", *GetAuthorityName(), *GetNameSafe(this), *GetNameSafe(RoomData.Get()));
+
+	// GeneratorOwner may not be replicated yet, but the replicated rooms are always outered to their generator.
+	ADungeonGeneratorBase* OwningGenerator = GetTypedOuter<ADungeonGeneratorBase>();
+	if (IsReady() && IsValid(OwningGenerator))
+		OwningGenerator->NotifyRoomReady(this);
 }
 
 void URoom::OnRep_Connections()
@@ -284,6 +383,10 @@ void URoom::OnRep_Connections()
 		// This may show 'None' for all rooms depending on the order of those weakptr resolutions.
 		DungeonLog_Debug("- %s (%d) <-> %s (%d)", *GetNameSafe(Connection->GetRoomA().Get()), Connection->GetRoomADoorId(), *GetNameSafe(Connection->GetRoomB().Get()), Connection->GetRoomBDoorId());
 	}
+
+	ADungeonGeneratorBase* OwningGenerator = GetTypedOuter<ADungeonGeneratorBase>();
+	if (IsValid(OwningGenerator))
+		OwningGenerator->NotifyRoomConnectionsChanged(this);
 }
 
 ARoomLevel* URoom::GetLevelScript() const
@@ -335,6 +438,16 @@ void URoom::CreateLevelComponents(ARoomLevel* LevelActor)
 	}
 }
 
+void URoom::DestroyLevelComponents()
+{
+	for (const auto& Pair : CustomData)
+	{
+		if (!IsValid(Pair.Data))
+			continue;
+		Pair.Data->DestroyLevelComponent();
+	}
+}
+
 EDoorDirection URoom::GetDoorWorldOrientation(int DoorIndex) const
 {
 	check(IsDoorIndexValid(DoorIndex));
@@ -708,7 +821,16 @@ bool URoom::SerializeObject(FStructuredArchive::FRecord& Record, bool bIsLoading
 
 		// Serializing the room actors *only* during the save here.
 		// They will be deserialized at a later time when loading a dungeon, once the room instance is spawned.
-		SerializeLevelActors(*SaveData, bIsLoading);
+		if (StreamingData.IsValid())
+		{
+			// The room instance is streamed out, so its actors state is already saved.
+			SaveData->LevelActor = StreamingData->LevelActor;
+			SaveData->Actors = StreamingData->Actors;
+		}
+		else
+		{
+			SerializeLevelActors(*SaveData, bIsLoading);
+		}
 	}
 
 	int32 NumCustomData = CustomData.Num();
@@ -801,6 +923,14 @@ void URoom::PostLoadDungeon_Implementation()
 {
 	check(SaveData);
 
+	// The room is not loaded yet (e.g. too far from the player).
+	// Its actors will be deserialized when its instance is initialized.
+	if (!IsInstanceInitialized())
+	{
+		StreamingData = MoveTemp(SaveData);
+		return;
+	}
+
 	// @TODO: Find a way to do it in the `OnInstanceLoaded` function.
 	SerializeLevelActors(*SaveData, true);
 
@@ -112,6 +112,11 @@ int32 URoomConnection::GetID() const
 	return ID;
 }
 
+void URoomConnection::SetID(int32 NewID)
+{
+	SET_SUBOBJECT_REPLICATED_PROPERTY_VALUE(ID, NewID);
+}
+
 const TWeakObjectPtr<URoom> URoomConnection::GetRoomA() const
 {
 	return RoomA;
@@ -262,10 +267,17 @@ ADoor* URoomConnection::InstantiateDoor(UWorld* World, AActor* Owner, bool bUseO
 		InstanceDoorRot = Owner->GetActorTransform().TransformRotation(InstanceDoorRot);
 	}
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = Owner;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	ADoor* Door = GetWorld()->SpawnActor<ADoor>(DoorClass, InstanceDoorPos, InstanceDoorRot.Rotator(), SpawnParams);
+	// Reuse a door of a previous dungeon if available
+	ADungeonGeneratorBase* Generator = Cast<ADungeonGeneratorBase>(Owner);
+	ADoor* Door = IsValid(Generator) ? Generator->AcquireDoor(DoorClass, FTransform(InstanceDoorRot, InstanceDoorPos)) : nullptr;
+
+	if (!IsValid(Door))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = Owner;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Door = GetWorld()->SpawnActor<ADoor>(DoorClass, InstanceDoorPos, InstanceDoorRot.Rotator(), SpawnParams);
+	}
 
 	if (!IsValid(Door))
 	{
@@ -281,6 +293,7 @@ ADoor* URoomConnection::InstantiateDoor(UWorld* World, AActor* Owner, bool bUseO
 		// Load door data back if we have some saved data.
 		SerializeUObject(SaveData->DoorSavedData, Door, true);
 		DungeonLog_Info("Loaded saved data for door '%s' (open: %d, lock: %d)", *GetNameSafe(Door), Door->ShouldBeOpened(), Door->ShouldBeLocked());
+		Door->UpdateDoorState();
 	}
 
 	return Door;
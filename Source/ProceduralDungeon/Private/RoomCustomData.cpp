@@ -63,6 +63,13 @@ void URoomCustomData::CreateLevelComponent(ARoomLevel* LevelActor)
 	}
 }
 
+void URoomCustomData::DestroyLevelComponent()
+{
+	if (LevelComponentInstance.IsValid())
+		LevelComponentInstance->DestroyComponent();
+	LevelComponentInstance.Reset();
+}
+
 bool URoomCustomData::SerializeObject(FStructuredArchive::FRecord& Record, bool bIsLoading)
 {
 	// Nothing more to serialize if no component
@@ -14,6 +14,9 @@
 #include "FileHelpers.h"
 #endif
 #include "Math/GenericOctree.h" // FBoxCenterAndExtent
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "ProceduralDungeonLog.h"
 
 #if !USE_LEGACY_DATA_VALIDATION
 	#include "Misc/DataValidation.h"
@@ -24,6 +27,13 @@ URoomData::URoomData()
 {
 }
 
+const TSoftObjectPtr<UWorld>& URoomData::GetLevelToLoad(const UWorld* World) const
+{
+	if (!ServerLevel.IsNull() && IsValid(World) && World->GetNetMode() == NM_DedicatedServer)
+		return ServerLevel;
+	return Level;
+}
+
 const FDoorDef& URoomData::GetDoorDef(int32 DoorIndex) const
 {
 	if (DoorIndex >= 0 && DoorIndex < Doors.Num())
@@ -215,6 +225,20 @@ bool URoomData::IsRoomInBounds(const FBoxMinAndMax& Bounds, int DoorIndex, const
 	return Bounds.IsInside(RoomBounds);
 }
 
+bool URoomData::HasDoorVisibility() const
+{
+	return DoorVisibility.Num() > 0 && DoorVisibilityDoors == Doors;
+}
+
+bool URoomData::CanDoorSeeDoor(int32 FromDoor, int32 ToDoor) const
+{
+	if (!HasDoorVisibility() || FromDoor < 0 || FromDoor >= Doors.Num() || ToDoor < 0 || ToDoor >= Doors.Num())
+		return true;
+
+	const int32 Bit = FromDoor * Doors.Num() + ToDoor;
+	return (DoorVisibility[Bit / 32] & (1u << (Bit % 32))) != 0;
+}
+
 int32 URoomData::GetPointIndex() const
 {
 	TArray<int32> OutKeys;
@@ -375,6 +399,20 @@ EDataValidationResult URoomData::IsDataValid(FDataValidationContext& Context) co
 		Result = EDataValidationResult::Invalid;
 	}
 
+	if (!ServerLevel.IsNull() && ServerLevel == Level)
+	{
+		VALIDATION_LOG_ERROR(FText::FromString(FString::Printf(TEXT("Room data \"%s\" has the same level set as server level. Leave the server level empty to load the level on servers too."), *GetName())));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	// The level instances are created in the folder of the loaded level, which must be the same on the server and the clients.
+	if (!ServerLevel.IsNull() && !Level.IsNull()
+		&& FPackageName::GetLongPackagePath(ServerLevel.GetLongPackageName()) != FPackageName::GetLongPackagePath(Level.GetLongPackageName()))
+	{
+		VALIDATION_LOG_ERROR(FText::FromString(FString::Printf(TEXT("Room data \"%s\" has a server level in another folder than its level. Both levels must be in the same folder."), *GetName())));
+		Result = EDataValidationResult::Invalid;
+	}
+
 	// Check if no room size is 0 on any axis
 	if (FirstPoint.X == SecondPoint.X
 		|| FirstPoint.Y == SecondPoint.Y
@@ -420,6 +458,87 @@ EDataValidationResult URoomData::IsDataValid(FDataValidationContext& Context) co
 }
 	#undef VALIDATION_LOG_ERROR
 
+namespace
+{
+	// Fills some points on the door opening, moved slightly inside the room to not hit the door frame.
+	void GetDoorSamplePoints(const FDoorDef& Door, TArray<FVector>& OutPoints)
+	{
+		constexpr float Inset = 10.0f;
+		constexpr float Spread = 0.6f;
+
+		const FBoxCenterAndExtent Bounds = Door.GetBounds();
+		const FVector Inward = -ToVector(Door.Direction);
+		const bool bAlongX = (Door.Direction == EDoorDirection::North || Door.Direction == EDoorDirection::South);
+		const FVector Width = bAlongX ? FVector(0, Bounds.Extent.Y, 0) : FVector(Bounds.Extent.X, 0, 0);
+		const FVector Height(0, 0, Bounds.Extent.Z);
+
+		OutPoints.Reset();
+		for (int32 X = -1; X <= 1; ++X)
+		{
+			for (int32 Z = -1; Z <= 1; ++Z)
+			{
+				OutPoints.Add(FVector(Bounds.Center) + Inset * Inward + Spread * (X * Width + Z * Height));
+			}
+		}
+	}
+} //namespace
+
+void URoomData::BakeDoorVisibility(const UWorld* World)
+{
+	if (!IsValid(World))
+		return;
+
+	const int32 DoorCount = Doors.Num();
+	DoorVisibility.Init(0, FMath::DivideAndRoundUp(DoorCount * DoorCount, 32));
+	DoorVisibilityDoors = Doors;
+
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(BakeDoorVisibility), /*bTraceComplex = */ true);
+	TArray<FVector> PointsA;
+	TArray<FVector> PointsB;
+	for (int32 A = 0; A < DoorCount; ++A)
+	{
+		GetDoorSamplePoints(Doors[A], PointsA);
+		for (int32 B = A; B < DoorCount; ++B)
+		{
+			bool bIsVisible = (A == B);
+
+			// The doors on the same wall, or facing away from each other, can't be seen through the room.
+			const FVector InwardA = -ToVector(Doors[A].Direction);
+			const FVector InwardB = -ToVector(Doors[B].Direction);
+			const FVector AToB = FVector(Doors[B].GetBounds().Center - Doors[A].GetBounds().Center);
+			const bool bFacing = FVector::DotProduct(AToB, InwardA) > 0.0f && FVector::DotProduct(-AToB, InwardB) > 0.0f;
+
+			if (!bIsVisible && bFacing)
+			{
+				GetDoorSamplePoints(Doors[B], PointsB);
+				for (int32 i = 0; !bIsVisible && i < PointsA.Num(); ++i)
+				{
+					for (int32 j = 0; !bIsVisible && j < PointsB.Num(); ++j)
+					{
+						bIsVisible = !World->LineTraceTestByChannel(PointsA[i], PointsB[j], ECC_Visibility, Params);
+					}
+				}
+			}
+
+			if (bIsVisible)
+			{
+				const int32 BitAB = A * DoorCount + B;
+				const int32 BitBA = B * DoorCount + A;
+				DoorVisibility[BitAB / 32] |= (1u << (BitAB % 32));
+				DoorVisibility[BitBA / 32] |= (1u << (BitBA % 32));
+			}
+		}
+	}
+
+	DungeonLog_Info("Baked the door visibility of room data \"%s\".", *GetName());
+}
+
+void URoomData::ClearDoorVisibility()
+{
+	DoorVisibility.Empty();
+	DoorVisibilityDoors.Empty();
+}
+
 void URoomData::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
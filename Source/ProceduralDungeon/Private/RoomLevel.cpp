@@ -23,6 +23,8 @@
 #include "Components/BoxComponent.h"
 #include "RoomVisibilityComponent.h"
 #include "RoomVisitor.h"
+#include "RoomVisitorSubsystem.h"
+#include "RoomLevelSubsystem.h"
 
 #if WITH_EDITOR
 bool ARoomLevel::bIsDungeonEditorMode = false;
@@ -69,7 +71,50 @@ void ARoomLevel::BeginPlay()
 		DungeonLog_Error("RoomLevel's Data does not match RoomData's Level [Data \"%s\" | Level \"%s\"]. Debug Draw will be incorrect.", *GetNameSafe(Room->GetRoomData()), *GetName());
 	}
 
-	// Create trigger box to track dynamic actors inside the room with IRoomVisitor
+	// The level may be reused by another room, so the trigger box could already exist
+	if (!IsValid(RoomTrigger))
+		CreateRoomTrigger();
+
+	// Update trigger box to have the room's bounds
+	FBoxCenterAndExtent LocalBounds = Room->GetLocalBounds();
+	RoomTrigger->SetRelativeLocationAndRotation(LocalBounds.Center, FQuat::Identity);
+	RoomTrigger->SetBoxExtent(LocalBounds.Extent, true);
+
+	CacheCullableActors();
+	SetActorsVisible(Room->IsVisible());
+
+	// Create dynamic components from the RoomCustomData
+	Room->CreateLevelComponents(this);
+
+	// Restore the actors state if the room has been streamed out before
+	Room->OnInstanceInitialized();
+
+	bIsInit = true;
+}
+
+void ARoomLevel::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// The level may be hidden to be reused by another room, so remove what belongs to this one.
+	if (IsValid(Room))
+		Room->DestroyLevelComponents();
+
+	ResetCullableActors();
+
+	Room = nullptr;
+	bIsInit = false;
+}
+
+void ARoomLevel::Recycle()
+{
+	OnRoomLevelRecycled();
+	OnRoomLevelRecycled_BP();
+}
+
+// Create trigger box to track dynamic actors inside the room with IRoomVisitor
+void ARoomLevel::CreateRoomTrigger()
+{
 	RoomTrigger = NewObject<UBoxComponent>(this, UBoxComponent::StaticClass(), FName("Room Trigger"));
 	RoomTrigger->RegisterComponent();
 	RoomTrigger->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
@@ -95,24 +140,6 @@ void ARoomLevel::BeginPlay()
 
 	RoomTrigger->OnComponentBeginOverlap.AddDynamic(this, &ARoomLevel::OnTriggerBeginOverlap);
 	RoomTrigger->OnComponentEndOverlap.AddDynamic(this, &ARoomLevel::OnTriggerEndOverlap);
-
-	// Update trigger box to have the room's bounds
-	FBoxCenterAndExtent LocalBounds = Room->GetLocalBounds();
-	RoomTrigger->SetRelativeLocationAndRotation(LocalBounds.Center, FQuat::Identity);
-	RoomTrigger->SetBoxExtent(LocalBounds.Extent, true);
-
-	SetActorsVisible(Room->IsVisible());
-
-	// Create dynamic components from the RoomCustomData
-	Room->CreateLevelComponents(this);
-
-	bIsInit = true;
-}
-
-void ARoomLevel::EndPlay(EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-	Room = nullptr;
 }
 
 // Update is called once per frame
@@ -238,30 +265,93 @@ void ARoomLevel::SetActorsVisible(bool Visible)
 		Visible = true;
 	}
 
-	ULevel* Level = GetLevel();
-	if (IsValid(Level))
+	if (!bAreCullableActorsCached)
+		CacheCullableActors();
+
+	if (Visible != bAreCullableActorsVisible)
 	{
-		for (AActor* Actor : Level->Actors)
+		bAreCullableActorsVisible = Visible;
+		for (const TWeakObjectPtr<AActor>& Actor : CullableActors)
 		{
-			if (!IsValid(Actor))
-				continue;
+			if (Actor.IsValid())
+				Actor->SetActorHiddenInGame(!Visible);
+		}
+	}
+
+	// Notify the change (useful for RoomVisibilityComponent)
+	VisibilityChangedEvent.Broadcast(this, Visible);
+}
+
+bool ARoomLevel::IsCullableActor(const AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return false;
+
+	// HACK: Don't manage replicated actors as their ActorHiddenInGame is replicated
+	// and will mess up the actor visibility on clients!
+	if (Actor->GetIsReplicated())
+		return false;
+
+	// Discard explicitly ignored actors.
+	// They can have a (Static) Room Visibility Component attached to have a custom occlusion management.
+	if (Actor->ActorHasTag(FName("Ignore Room Culling")))
+		return false;
+
+	return true;
+}
+
+void ARoomLevel::CacheCullableActors()
+{
+	ResetCullableActors();
+	bAreCullableActorsCached = true;
+
+	ULevel* Level = GetLevel();
+	if (!IsValid(Level))
+		return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (IsCullableActor(Actor))
+			CullableActors.Add(Actor);
+	}
 
-			// HACK: Don't manage replicated actors as their ActorHiddenInGame is replicated
-			// and will mess up the actor visibility on clients!
-			if (Actor->GetIsReplicated())
-				continue;
+	UWorld* World = GetWorld();
+	if (URoomLevelSubsystem* Subsystem = World ? World->GetSubsystem<URoomLevelSubsystem>() : nullptr)
+		Subsystem->RegisterRoomLevel(this);
+}
 
-			// Discard explicitly ignored actors.
-			// They can have a (Static) Room Visibility Component attached to have a custom occlusion management.
-			if (Actor->ActorHasTag(FName("Ignore Room Culling")))
-				continue;
+void ARoomLevel::ResetCullableActors()
+{
+	if (bAreCullableActorsCached)
+	{
+		UWorld* World = GetWorld();
+		if (URoomLevelSubsystem* Subsystem = World ? World->GetSubsystem<URoomLevelSubsystem>() : nullptr)
+			Subsystem->UnregisterRoomLevel(this);
+	}
 
-			Actor->SetActorHiddenInGame(!Visible);
+	// Shows back the hidden actors, in case the level is reused by another room.
+	if (!bAreCullableActorsVisible)
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : CullableActors)
+		{
+			if (Actor.IsValid())
+				Actor->SetActorHiddenInGame(false);
 		}
 	}
 
-	// Notify the change (useful for RoomVisibilityComponent)
-	VisibilityChangedEvent.Broadcast(this, Visible);
+	CullableActors.Reset();
+	bAreCullableActorsCached = false;
+	bAreCullableActorsVisible = true;
+}
+
+void ARoomLevel::OnActorSpawned(AActor* Actor)
+{
+	if (!IsCullableActor(Actor))
+		return;
+
+	CullableActors.Add(Actor);
+	if (!bAreCullableActorsVisible)
+		Actor->SetActorHiddenInGame(true);
 }
 
 void ARoomLevel::UpdateVisitor(UObject* Visitor, bool IsInside)
@@ -285,21 +375,36 @@ void ARoomLevel::TriggerActor(AActor* Actor, bool IsInTrigger)
 	if (!IsValid(Actor))
 		return;
 
-	// Call the interface on the actor itself
+	// The actors registered in the visitor subsystem are tracked by it instead.
+	const URoomVisitorSubsystem* VisitorSubsystem = GetWorld()->GetSubsystem<URoomVisitorSubsystem>();
+	if (VisitorSubsystem && VisitorSubsystem->IsVisitorRegistered(Actor))
+		return;
+
+	// Call the interface on the actor itself and on its components too
+	TArray<UObject*> VisitorObjects;
 	if (Actor->Implements<URoomVisitor>())
 	{
-		UpdateVisitor(Actor, IsInTrigger);
+		VisitorObjects.Add(Actor);
 	}
 
-	// Call the interface on its components too
 	TArray<UActorComponent*, FDefaultAllocator> VisitorComps = Actor->GetComponentsByInterface(URoomVisitor::StaticClass());
 	for (UActorComponent* VisitorComp : VisitorComps)
 	{
 		check(VisitorComp);
-		UpdateVisitor(VisitorComp, IsInTrigger);
+		VisitorObjects.Add(VisitorComp);
+	}
+
+	TriggerVisitors(Actor, VisitorObjects, IsInTrigger);
+}
+
+void ARoomLevel::TriggerVisitors(AActor* Actor, const TArray<UObject*>& VisitorObjects, bool IsInside)
+{
+	for (UObject* Visitor : VisitorObjects)
+	{
+		UpdateVisitor(Visitor, IsInside);
 	}
 
-	if (IsInTrigger)
+	if (IsInside)
 		ActorEnterRoomEvent.Broadcast(this, Actor);
 	else
 		ActorExitRoomEvent.Broadcast(this, Actor);
@@ -0,0 +1,65 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#include "RoomLevelSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "RoomLevel.h"
+
+void URoomLevelSubsystem::Deinitialize()
+{
+	RemoveActorSpawnedHandler();
+	RoomLevels.Empty();
+	Super::Deinitialize();
+}
+
+void URoomLevelSubsystem::RegisterRoomLevel(ARoomLevel* RoomLevel)
+{
+	check(IsValid(RoomLevel));
+	ULevel* Level = RoomLevel->GetLevel();
+	if (!IsValid(Level))
+		return;
+
+	RoomLevels.Add(Level, RoomLevel);
+
+	UWorld* World = GetWorld();
+	if (!ActorSpawnedHandle.IsValid() && World)
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &URoomLevelSubsystem::OnActorSpawned));
+}
+
+void URoomLevelSubsystem::UnregisterRoomLevel(ARoomLevel* RoomLevel)
+{
+	// The unloaded levels are removed too.
+	for (auto It = RoomLevels.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid() || !It->Value.IsValid() || It->Value.Get() == RoomLevel)
+			It.RemoveCurrent();
+	}
+
+	if (RoomLevels.Num() == 0)
+		RemoveActorSpawnedHandler();
+}
+
+void URoomLevelSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	const TWeakObjectPtr<ARoomLevel>* RoomLevel = RoomLevels.Find(Actor->GetLevel());
+	if (RoomLevel != nullptr && RoomLevel->IsValid())
+		(*RoomLevel)->OnActorSpawned(Actor);
+}
+
+void URoomLevelSubsystem::RemoveActorSpawnedHandler()
+{
+	if (!ActorSpawnedHandle.IsValid())
+		return;
+
+	if (UWorld* World = GetWorld())
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	ActorSpawnedHandle.Reset();
+}
@@ -0,0 +1,210 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#include "RoomVisitorSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "TimerManager.h"
+#include "Components/BoxComponent.h"
+#include "DungeonGeneratorBase.h"
+#include "DungeonGraph.h"
+#include "Room.h"
+#include "RoomLevel.h"
+#include "RoomVisitor.h"
+#include "ProceduralDungeonUtils.h"
+#include "ProceduralDungeonLog.h"
+
+void URoomVisitorSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+		World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+
+	Visitors.Empty();
+	Super::Deinitialize();
+}
+
+void URoomVisitorSubsystem::RegisterVisitor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		DungeonLog_Error("Can't register an invalid actor as room visitor.");
+		return;
+	}
+
+	if (Visitors.Contains(Actor))
+		return;
+
+	FVisitor& Visitor = Visitors.Add(Actor);
+	if (Actor->Implements<URoomVisitor>())
+		Visitor.Objects.Add(Actor);
+
+	for (UActorComponent* Component : Actor->GetComponentsByInterface(URoomVisitor::StaticClass()))
+	{
+		check(Component);
+		Visitor.Objects.Add(Component);
+	}
+
+	// The actor has already entered the rooms with a trigger overlapping it, so they don't dispatch their enter events again.
+	TSet<ARoomLevel*> OverlappingRoomLevels;
+	GetOverlappingRoomLevels(Actor, OverlappingRoomLevels);
+	for (ARoomLevel* RoomLevel : OverlappingRoomLevels)
+	{
+		Visitor.RoomLevels.Add(RoomLevel);
+	}
+
+	UpdateTimer();
+}
+
+void URoomVisitorSubsystem::UnregisterVisitor(AActor* Actor)
+{
+	FVisitor Visitor;
+	if (!Visitors.RemoveAndCopyValue(Actor, Visitor))
+		return;
+
+	// The actor stays in (or enters) the rooms with a trigger overlapping it, since their trigger will dispatch the exit events.
+	TSet<ARoomLevel*> OverlappingRoomLevels;
+	if (IsValid(Actor))
+		GetOverlappingRoomLevels(Actor, OverlappingRoomLevels);
+
+	DispatchRoomEvents(Actor, Visitor, OverlappingRoomLevels);
+	UpdateTimer();
+}
+
+bool URoomVisitorSubsystem::IsVisitorRegistered(const AActor* Actor) const
+{
+	return Visitors.Contains(Actor);
+}
+
+void URoomVisitorSubsystem::UpdateVisitors()
+{
+	TArray<const ADungeonGeneratorBase*> Generators;
+	for (TActorIterator<ADungeonGeneratorBase> It(GetWorld()); It; ++It)
+	{
+		if (IsValid(It->GetRooms()))
+			Generators.Add(*It);
+	}
+
+	// The events may register or unregister visitors, so the actors are gathered before dispatching them.
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	Visitors.GetKeys(Actors);
+
+	TSet<URoom*> Rooms;
+	TSet<ARoomLevel*> RoomLevels;
+	for (const TWeakObjectPtr<AActor>& ActorPtr : Actors)
+	{
+		AActor* Actor = ActorPtr.Get();
+		if (!IsValid(Actor))
+		{
+			Visitors.Remove(ActorPtr);
+			continue;
+		}
+
+		FVisitor* Visitor = Visitors.Find(ActorPtr);
+		if (Visitor == nullptr)
+			continue;
+
+		RoomLevels.Reset();
+		for (const ADungeonGeneratorBase* Generator : Generators)
+		{
+			const FVector Location = Generator->GetDungeonTransform().InverseTransformPositionNoScale(Actor->GetActorLocation());
+			Rooms.Reset();
+			Generator->GetRooms()->GetRoomsInBox(FBox(Location, Location), Rooms);
+			for (const URoom* Room : Rooms)
+			{
+				ARoomLevel* RoomLevel = Room->GetLevelScript();
+				if (IsValid(RoomLevel) && RoomLevel->IsInit())
+					RoomLevels.Add(RoomLevel);
+			}
+		}
+
+		DispatchRoomEvents(Actor, *Visitor, RoomLevels);
+	}
+
+	// Picks up the changes of the update interval.
+	UpdateTimer();
+}
+
+void URoomVisitorSubsystem::UpdateTimer()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	if (Visitors.Num() == 0)
+	{
+		TimerManager.ClearTimer(UpdateTimerHandle);
+		return;
+	}
+
+	const float UpdateInterval = Dungeon::RoomVisitorUpdateInterval();
+	if (TimerManager.IsTimerActive(UpdateTimerHandle) && UpdateInterval == CurrentUpdateInterval)
+		return;
+
+	CurrentUpdateInterval = UpdateInterval;
+	TimerManager.SetTimer(UpdateTimerHandle, this, &URoomVisitorSubsystem::UpdateVisitors, UpdateInterval, /*bLoop = */ true);
+}
+
+void URoomVisitorSubsystem::GetOverlappingRoomLevels(const AActor* Actor, TSet<ARoomLevel*>& OutRoomLevels)
+{
+	TArray<AActor*> OverlappingActors;
+	Actor->GetOverlappingActors(OverlappingActors, ARoomLevel::StaticClass());
+	for (AActor* OverlappingActor : OverlappingActors)
+	{
+		ARoomLevel* RoomLevel = Cast<ARoomLevel>(OverlappingActor);
+		if (IsValid(RoomLevel) && RoomLevel->IsInit() && IsValid(RoomLevel->RoomTrigger) && RoomLevel->RoomTrigger->IsOverlappingActor(Actor))
+			OutRoomLevels.Add(RoomLevel);
+	}
+}
+
+void URoomVisitorSubsystem::DispatchRoomEvents(AActor* Actor, FVisitor& Visitor, const TSet<ARoomLevel*>& NewRoomLevels)
+{
+	// The visitor is updated before dispatching the events, since they may register or unregister visitors.
+	TArray<ARoomLevel*> ExitedRoomLevels;
+	for (auto It = Visitor.RoomLevels.CreateIterator(); It; ++It)
+	{
+		ARoomLevel* RoomLevel = It->Get();
+		if (RoomLevel != nullptr && NewRoomLevels.Contains(RoomLevel))
+			continue;
+
+		// The unloaded room levels are just forgotten.
+		if (IsValid(RoomLevel))
+			ExitedRoomLevels.Add(RoomLevel);
+		It.RemoveCurrent();
+	}
+
+	TArray<ARoomLevel*> EnteredRoomLevels;
+	for (ARoomLevel* RoomLevel : NewRoomLevels)
+	{
+		bool bIsAlreadyInside = false;
+		Visitor.RoomLevels.Add(RoomLevel, &bIsAlreadyInside);
+		if (!bIsAlreadyInside)
+			EnteredRoomLevels.Add(RoomLevel);
+	}
+
+	if (ExitedRoomLevels.Num() == 0 && EnteredRoomLevels.Num() == 0)
+		return;
+
+	TArray<UObject*> Objects;
+	for (const TWeakObjectPtr<UObject>& Object : Visitor.Objects)
+	{
+		if (Object.IsValid())
+			Objects.Add(Object.Get());
+	}
+
+	for (ARoomLevel* RoomLevel : ExitedRoomLevels)
+	{
+		if (IsValid(RoomLevel))
+			RoomLevel->TriggerVisitors(Actor, Objects, false);
+	}
+
+	for (ARoomLevel* RoomLevel : EnteredRoomLevels)
+	{
+		if (IsValid(RoomLevel))
+			RoomLevel->TriggerVisitors(Actor, Objects, true);
+	}
+}
@@ -0,0 +1,35 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#pragma once
+
+#include "InfiniteDungeonGenerator.h"
+#include "InfiniteDungeonGeneratorClasses.generated.h"
+
+class URoomData;
+
+// Always uses the same room data and exposes the dungeon creation to the tests.
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, meta = (HiddenNode))
+class AInfiniteDungeonGeneratorTest : public AInfiniteDungeonGenerator
+{
+	GENERATED_BODY()
+
+public:
+	bool Generate() { return CreateDungeon(); }
+
+	virtual URoomData* ChooseFirstRoomData_Implementation() override { return RoomData; }
+	virtual URoomData* ChooseNextRoomData_Implementation(const URoomData* CurrentRoom, const FDoorDef& DoorData, int& DoorIndex) override
+	{
+		DoorIndex = -1;
+		return RoomData;
+	}
+	virtual bool IsValidDungeon_Implementation() override { return true; }
+
+public:
+	UPROPERTY()
+	URoomData* RoomData {nullptr};
+};
@@ -11,6 +11,8 @@
 #include "DungeonGraph.h"
 #include "Room.h"
 #include "RoomData.h"
+#include "RoomConnection.h"
+#include "ProceduralDungeonUtils.h"
 #include "TestUtils.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -167,6 +169,147 @@ bool FDungeonGraphTest::RunTest(const FString& Parameters)
 			CLEAN_TEST();
 		}
 
+		// Test branch removal
+		{
+			INIT_TEST(Graph);
+
+			// B-B-C-A
+			//   | |
+			//   A B
+			//     |
+			//     A
+
+			CREATE_ROOM(Room0, DA_C);
+			CREATE_ROOM(Room1, DA_B);
+			CREATE_ROOM(Room2, DA_B);
+			CREATE_ROOM(Room3, DA_A);
+			CREATE_ROOM(Room4, DA_A);
+
+			Graph->Connect(Room0, 0, Room1, 1);
+			Graph->Connect(Room1, 0, Room2, 1);
+			Graph->Connect(Room2, 0, Room3, 0);
+			Graph->Connect(Room0, 1, Room4, 0);
+
+			TArray<URoom*> Branch;
+			Graph->GetBranchRooms(Room0, 0, Branch);
+			TestEqual(TEXT("Branch from Room0 door 0 should have 3 rooms"), Branch.Num(), 3);
+			TestTrue(TEXT("Branch should have Room1, Room2 and Room3"), Branch.Contains(Room1) && Branch.Contains(Room2) && Branch.Contains(Room3));
+
+			TArray<URoom*> OtherBranch;
+			Graph->GetBranchRooms(Room1, 1, OtherBranch);
+			TestEqual(TEXT("Branch from Room1 door 1 should have 2 rooms"), OtherBranch.Num(), 2);
+			TestTrue(TEXT("Branch should have Room0 and Room4"), OtherBranch.Contains(Room0) && OtherBranch.Contains(Room4));
+
+			Graph->GetBranchRooms(Room0, 2, OtherBranch);
+			TestEqual(TEXT("Branch from an unconnected door should be empty"), OtherBranch.Num(), 0);
+
+			Graph->RemoveRooms(Branch);
+			TestEqual(TEXT("Graph should have 2 rooms"), Graph->Count(), 2);
+			TestEqual(TEXT("Graph should have 2 connections"), Graph->GetAllConnections().Num(), 2);
+			TestFalse(TEXT("Room0 door 0 should not be connected anymore"), Room0->IsConnected(0));
+			TestNotNull(TEXT("Room0 door 0 should have an empty connection"), Room0->GetConnection(0));
+			TestTrue(TEXT("Room0 door 1 should still be connected"), Room0->IsConnected(1));
+			TestEqual(TEXT("Room IDs should not be reused"), Graph->GetNextRoomId(), 5);
+			for (int32 i = 0; i < Graph->GetAllConnections().Num(); ++i)
+			{
+				TestEqual(TEXT("Connection ID should match its index"), Graph->GetAllConnections()[i]->GetID(), i);
+			}
+
+			CLEAN_TEST();
+		}
+
+		// Test rooms in distance
+		{
+			INIT_TEST(Graph);
+
+			// A-B-C-B-A
+			//     |
+			//     A
+
+			CREATE_ROOM(Room0, DA_A);
+			CREATE_ROOM(Room1, DA_B);
+			CREATE_ROOM(Room2, DA_C);
+			CREATE_ROOM(Room3, DA_B);
+			CREATE_ROOM(Room4, DA_A);
+			CREATE_ROOM(Room5, DA_A);
+
+			Graph->Connect(Room0, 0, Room1, 1);
+			Graph->Connect(Room1, 0, Room2, 1);
+			Graph->Connect(Room2, 0, Room3, 1);
+			Graph->Connect(Room3, 0, Room4, 0);
+			Graph->Connect(Room2, 2, Room5, 0);
+
+			TSet<URoom*> Expected;
+			TSet<URoom*> Result;
+			for (uint32 Distance = 0; Distance < 5; ++Distance)
+			{
+				UDungeonGraph::TraverseRooms({Room0}, &Expected, Distance, [](URoom*) {});
+				Graph->GetRoomsInDistance({Room0}, Distance, Result);
+				TestTrue(FString::Printf(TEXT("Rooms in distance %u of Room0 should match TraverseRooms"), Distance), Result.Num() == Expected.Num() && Result.Includes(Expected));
+
+				UDungeonGraph::TraverseRooms({Room1, Room5}, &Expected, Distance, [](URoom*) {});
+				Graph->GetRoomsInDistance({Room1, Room5}, Distance, Result);
+				TestTrue(FString::Printf(TEXT("Rooms in distance %u of Room1 and Room5 should match TraverseRooms"), Distance), Result.Num() == Expected.Num() && Result.Includes(Expected));
+
+				// Without door visibility baked in the room data, all the rooms in distance are visible.
+				Graph->GetVisibleRoomsInDistance({Room1, Room5}, Distance, Result);
+				TestTrue(FString::Printf(TEXT("Visible rooms in distance %u of Room1 and Room5 should match TraverseRooms"), Distance), Result.Num() == Expected.Num() && Result.Includes(Expected));
+			}
+
+			Graph->GetRoomsInDistance({Room2}, 2, Result);
+			TestEqual(TEXT("Room2 should have 4 rooms in distance 2"), Result.Num(), 4);
+
+			// The tables must be updated when the dungeon changes
+			TArray<URoom*> Branch;
+			Graph->GetBranchRooms(Room2, 0, Branch);
+			Graph->RemoveRooms(Branch);
+			Graph->GetRoomsInDistance({Room2}, 2, Result);
+			TestEqual(TEXT("Room2 should have 3 rooms in distance 2 after removing a branch"), Result.Num(), 3);
+			TestFalse(TEXT("Room3 should not be in distance anymore"), Result.Contains(Room3));
+
+			CLEAN_TEST();
+		}
+
+		// Test visible rooms in distance
+		{
+			INIT_TEST(Graph);
+
+			// Same doors as DA_B, but with a door visibility baked where its doors can't see each other.
+			CREATE_ROOM_DATA(DA_Wall);
+			DA_Wall->Doors = DA_B->Doors;
+			DA_Wall->DoorVisibility.Init(0, 1);
+			DA_Wall->DoorVisibilityDoors = DA_Wall->Doors;
+
+			// A-Wall-B-A
+
+			CREATE_ROOM(Room0, DA_A);
+			CREATE_ROOM(Room1, DA_Wall);
+			CREATE_ROOM(Room2, DA_B);
+			CREATE_ROOM(Room3, DA_A);
+
+			Graph->Connect(Room0, 0, Room1, 1);
+			Graph->Connect(Room1, 0, Room2, 1);
+			Graph->Connect(Room2, 0, Room3, 0);
+
+			TSet<URoom*> Result;
+			Graph->GetVisibleRoomsInDistance({Room0}, 4, Result);
+			TestTrue(TEXT("Only Room0 and Room1 should be visible from Room0"), Result.Num() == 2 && Result.Contains(Room0) && Result.Contains(Room1));
+
+			Graph->GetVisibleRoomsInDistance({Room1}, 4, Result);
+			TestEqual(TEXT("All the rooms should be visible from inside Room1"), Result.Num(), 4);
+
+			Graph->GetVisibleRoomsInDistance({Room2}, 4, Result);
+			TestTrue(TEXT("Room0 should not be visible from Room2"), Result.Num() == 3 && !Result.Contains(Room0));
+
+			Graph->GetVisibleRoomsInDistance({Room3}, 2, Result);
+			TestTrue(TEXT("Only Room3 and Room2 should be visible in distance 2 of Room3"), Result.Num() == 2 && Result.Contains(Room3) && Result.Contains(Room2));
+
+			Graph->GetRoomsInDistance({Room0}, 4, Result);
+			TestEqual(TEXT("All the rooms should still be in distance 4 of Room0"), Result.Num(), 4);
+
+			CLEAN_TEST();
+		}
+
 		// Test Voxel Bounds Conversions
 		{
 			INIT_TEST(Graph);
@@ -287,6 +430,40 @@ bool FDungeonGraphTest::RunTest(const FString& Parameters)
 				FVoxelBounds ConvertedBounds = Room5->GetVoxelBounds();
 				TestEqual(TEXT("Room5 bounds should be as expected"), ConvertedBounds, ExpectedBounds);
 			}
+
+			// Check the rooms found in boxes
+			{
+				const FVector Unit = Dungeon::RoomUnit();
+				const FVector Extent(10.0f);
+				auto CellCenter = [&Unit](const FIntVector& Cell) { return Unit * (FVector(Cell) + FVector(0.0f, 0.0f, 0.5f)); };
+
+				TSet<URoom*> Result;
+				TestTrue(TEXT("Box in a cell should be looked up"), Graph->GetRoomsInBox(FBox::BuildAABB(CellCenter({0, 1, 0}), Extent), Result));
+				TestTrue(TEXT("Box in Room1 should find only Room1"), Result.Num() == 1 && Result.Contains(Room1));
+
+				Result.Reset();
+				Graph->GetRoomsInBox(FBox::BuildAABB(CellCenter({-1, 0, 1}), Extent), Result);
+				TestTrue(TEXT("Box in the second floor of Room3 should find only Room3"), Result.Num() == 1 && Result.Contains(Room3));
+
+				Result.Reset();
+				Graph->GetRoomsInBox(FBox::BuildAABB(0.5f * (CellCenter({0, 0, 0}) + CellCenter({0, 1, 0})), Extent), Result);
+				TestTrue(TEXT("Box between Room0 and Room1 should find both"), Result.Num() == 2 && Result.Contains(Room0) && Result.Contains(Room1));
+
+				Result.Reset();
+				Graph->GetRoomsInBox(FBox::BuildAABB(CellCenter({5, 5, 5}), Extent), Result);
+				TestEqual(TEXT("Box outside of the dungeon should find no room"), Result.Num(), 0);
+
+				Result.Reset();
+				TestFalse(TEXT("Box overlapping more cells than the limit should not be looked up"), Graph->GetRoomsInBox(FBox::BuildAABB(0.5f * (CellCenter({0, 0, 0}) + CellCenter({0, 1, 0})), Extent), Result, 1));
+				TestEqual(TEXT("Box not looked up should find no room"), Result.Num(), 0);
+			}
+
+			// Check the rooms found at cells
+			{
+				TestTrue(TEXT("Cell {0,1,0} should be in Room1"), Graph->GetRoomAt({0, 1, 0}) == Room1);
+				TestTrue(TEXT("Cell {-1,0,1} should be in Room3"), Graph->GetRoomAt({-1, 0, 1}) == Room3);
+				TestNull(TEXT("Cell {5,5,5} should be in no room"), Graph->GetRoomAt({5, 5, 5}));
+			}
 		}
 
 		// FilterAndSort Test
@@ -0,0 +1,109 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "InfiniteDungeonGenerator.h"
+#include "DungeonGraph.h"
+#include "Room.h"
+#include "RoomData.h"
+#include "TestUtils.h"
+#include "Classes/InfiniteDungeonGeneratorClasses.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInfiniteDungeonGeneratorTest, "ProceduralDungeon.Generators.InfiniteDungeonGenerator", FLAG_APPLICATION_CONTEXT | EAutomationTestFlags::SmokeFilter)
+
+bool FInfiniteDungeonGeneratorTest::RunTest(const FString& Parameters)
+{
+	// The default generator uses regions of 10x10x10 cells.
+	const AInfiniteDungeonGenerator* Generator = GetDefault<AInfiniteDungeonGenerator>();
+	TestTrue(TEXT("Default region size should be 10x10x10"), Generator->RegionSize == FIntVector(10, 10, 10));
+
+	// Region boundaries
+	{
+		TestTrue(TEXT("Cell {0,0,0} should be in region {0,0,0}"), Generator->GetRegionAt({0, 0, 0}) == FIntVector(0, 0, 0));
+		TestTrue(TEXT("Cell {9,9,9} should be in region {0,0,0}"), Generator->GetRegionAt({9, 9, 9}) == FIntVector(0, 0, 0));
+		TestTrue(TEXT("Cell {10,0,0} should be in region {1,0,0}"), Generator->GetRegionAt({10, 0, 0}) == FIntVector(1, 0, 0));
+		TestTrue(TEXT("Cell {0,19,20} should be in region {0,1,2}"), Generator->GetRegionAt({0, 19, 20}) == FIntVector(0, 1, 2));
+	}
+
+	// Negative cells are rounded toward negative infinity
+	{
+		TestTrue(TEXT("Cell {-1,0,0} should be in region {-1,0,0}"), Generator->GetRegionAt({-1, 0, 0}) == FIntVector(-1, 0, 0));
+		TestTrue(TEXT("Cell {-10,-10,-10} should be in region {-1,-1,-1}"), Generator->GetRegionAt({-10, -10, -10}) == FIntVector(-1, -1, -1));
+		TestTrue(TEXT("Cell {-11,0,-9} should be in region {-2,0,-1}"), Generator->GetRegionAt({-11, 0, -9}) == FIntVector(-2, 0, -1));
+	}
+
+	// Region seeds
+	{
+		const int32 Seed = Generator->GetRegionSeed({0, 0, 0});
+		TestEqual(TEXT("Same region should always have the same seed"), Generator->GetRegionSeed({0, 0, 0}), Seed);
+		TestNotEqual(TEXT("Region {1,0,0} should have another seed than {0,0,0}"), Generator->GetRegionSeed({1, 0, 0}), Seed);
+		TestNotEqual(TEXT("Region {0,1,0} should have another seed than {0,0,0}"), Generator->GetRegionSeed({0, 1, 0}), Seed);
+		TestNotEqual(TEXT("Region {0,0,1} should have another seed than {0,0,0}"), Generator->GetRegionSeed({0, 0, 1}), Seed);
+		TestNotEqual(TEXT("Region {-1,0,0} should have another seed than {0,0,0}"), Generator->GetRegionSeed({-1, 0, 0}), Seed);
+		TestNotEqual(TEXT("Region {1,0,0} should have another seed than {0,1,0}"), Generator->GetRegionSeed({1, 0, 0}), Generator->GetRegionSeed({0, 1, 0}));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInfiniteDungeonGeneratorGrowTest, "ProceduralDungeon.Generators.InfiniteDungeonGenerator.Grow", FLAG_APPLICATION_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FInfiniteDungeonGeneratorGrowTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// A single cell room with a door on each side, so every cell of the floor can be reached.
+	CREATE_DATA_ASSET(URoomData, Data);
+	Data->Doors.Add({{0, 0, 0}, EDoorDirection::North});
+	Data->Doors.Add({{0, 0, 0}, EDoorDirection::East});
+	Data->Doors.Add({{0, 0, 0}, EDoorDirection::South});
+	Data->Doors.Add({{0, 0, 0}, EDoorDirection::West});
+
+	AInfiniteDungeonGeneratorTest* Generator = World->SpawnActor<AInfiniteDungeonGeneratorTest>();
+	Generator->RoomData = Data.Get();
+	Generator->RegionSize = {2, 2, 1};
+	Generator->LoadDistance = 1;
+
+	TestTrue(TEXT("Dungeon should be created"), Generator->Generate());
+
+	TSet<FIntVector> FilledRegions;
+	for (const URoom* Room : Generator->GetRooms()->GetAllRooms())
+	{
+		FilledRegions.Add(Generator->GetRegionAt(Room->GetPosition()));
+	}
+
+	// Every region of the floor is reachable by a door, including the diagonal ones.
+	for (int32 Y = -1; Y <= 1; ++Y)
+	{
+		for (int32 X = -1; X <= 1; ++X)
+		{
+			const FIntVector Region(X, Y, 0);
+			TestTrue(FString::Printf(TEXT("Region %s should have rooms"), *Region.ToString()), FilledRegions.Contains(Region));
+			TestTrue(FString::Printf(TEXT("Region %s should be generated"), *Region.ToString()), Generator->IsRegionGenerated(Region));
+		}
+	}
+
+	// No door leads to the floors above and below.
+	TestFalse(TEXT("Region {0,0,1} should have no room"), FilledRegions.Contains({0, 0, 1}));
+	TestFalse(TEXT("Region {0,0,-1} should have no room"), FilledRegions.Contains({0, 0, -1}));
+	TestFalse(TEXT("Region {0,0,1} should not be generated"), Generator->IsRegionGenerated({0, 0, 1}));
+	TestEqual(TEXT("Rooms should fill every cell of the floor"), Generator->GetRooms()->Count(), 36);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,86 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Utils/PortalCulling.h"
+#include "TestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Fills a quad facing the X axis, centered at the provided location.
+	void MakeQuad(const FVector& Center, float HalfSize, FVector (&OutCorners)[4])
+	{
+		OutCorners[0] = Center + FVector(0, -HalfSize, -HalfSize);
+		OutCorners[1] = Center + FVector(0, HalfSize, -HalfSize);
+		OutCorners[2] = Center + FVector(0, HalfSize, HalfSize);
+		OutCorners[3] = Center + FVector(0, -HalfSize, HalfSize);
+	}
+} //namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPortalCullingTest, "ProceduralDungeon.Utils.PortalCulling", FLAG_APPLICATION_CONTEXT | EAutomationTestFlags::SmokeFilter)
+
+bool FPortalCullingTest::RunTest(const FString& Parameters)
+{
+	// Camera at the origin looking along the X axis, with a 90 degrees square field of view.
+	const FPortalFrustum Frustum(FVector::ZeroVector, FRotator::ZeroRotator, 90.0f, 1.0f);
+	TestEqual(TEXT("Camera frustum has 4 planes"), Frustum.Planes.Num(), 4);
+
+	// Quads tested against the camera frustum
+	{
+		FVector Quad[4];
+
+		MakeQuad(FVector(500, 0, 0), 100, Quad);
+		TestTrue(TEXT("Quad in front is visible"), Frustum.IntersectsQuad(Quad));
+
+		MakeQuad(FVector(-500, 0, 0), 100, Quad);
+		TestFalse(TEXT("Quad behind is not visible"), Frustum.IntersectsQuad(Quad));
+
+		MakeQuad(FVector(500, 1000, 0), 100, Quad);
+		TestFalse(TEXT("Quad on the right is not visible"), Frustum.IntersectsQuad(Quad));
+
+		MakeQuad(FVector(500, 0, -1000), 100, Quad);
+		TestFalse(TEXT("Quad below is not visible"), Frustum.IntersectsQuad(Quad));
+
+		MakeQuad(FVector(500, 550, 0), 100, Quad);
+		TestTrue(TEXT("Quad on the frustum edge is visible"), Frustum.IntersectsQuad(Quad));
+	}
+
+	// Quads tested through a portal
+	{
+		FVector Portal[4];
+		MakeQuad(FVector(500, 0, 0), 100, Portal);
+		const FPortalFrustum Clipped = Frustum.ClipThroughQuad(Portal);
+		TestEqual(TEXT("Clipped frustum has 9 planes"), Clipped.Planes.Num(), 9);
+
+		FVector Quad[4];
+
+		MakeQuad(FVector(1000, 0, 0), 100, Quad);
+		TestTrue(TEXT("Quad behind the portal is visible"), Clipped.IntersectsQuad(Quad));
+
+		MakeQuad(FVector(1000, 500, 0), 100, Quad);
+		TestFalse(TEXT("Quad beside the portal is not visible"), Clipped.IntersectsQuad(Quad));
+
+		MakeQuad(FVector(300, 0, 0), 50, Quad);
+		TestFalse(TEXT("Quad between the camera and the portal is not visible"), Clipped.IntersectsQuad(Quad));
+	}
+
+	// Viewer standing in the portal
+	{
+		FVector Portal[4];
+		MakeQuad(FVector::ZeroVector, 100, Portal);
+		const FPortalFrustum Clipped = Frustum.ClipThroughQuad(Portal);
+		TestEqual(TEXT("Portal does not narrow the view of a viewer inside it"), Clipped.Planes.Num(), Frustum.Planes.Num());
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
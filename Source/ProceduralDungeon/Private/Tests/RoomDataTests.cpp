@@ -403,6 +403,39 @@ bool FRoomDataTests::RunTest(const FString& Parameters)
 		}
 	}
 
+	// Test CanDoorSeeDoor
+	{
+		// 6 doors so the bits (A * 6 + B) of the door visibility span 2 words.
+		CREATE_ROOM_DATA(RoomData);
+		for (int32 i = 0; i < 6; ++i)
+		{
+			ADD_DOOR(RoomData, FIntVector::ZeroValue, EDoorDirection::North, nullptr);
+		}
+
+		TestFalse(TEXT("Door visibility should not be baked"), RoomData->HasDoorVisibility());
+		TestTrue(TEXT("All doors should see each other when not baked"), RoomData->CanDoorSeeDoor(0, 1));
+
+		// Door 0 sees door 2 (bit 2), door 4 sees door 5 (bit 29) and door 5 sees door 4 (bit 34).
+		RoomData->DoorVisibility.Init(0, 2);
+		RoomData->DoorVisibility[0] = (1u << 2) | (1u << 29);
+		RoomData->DoorVisibility[1] = (1u << 2);
+		RoomData->DoorVisibilityDoors = RoomData->Doors;
+
+		TestTrue(TEXT("Door visibility should be baked"), RoomData->HasDoorVisibility());
+		TestTrue(TEXT("Door 0 should see door 2"), RoomData->CanDoorSeeDoor(0, 2));
+		TestFalse(TEXT("Door 2 should not see door 0"), RoomData->CanDoorSeeDoor(2, 0));
+		TestFalse(TEXT("Door 0 should not see door 1"), RoomData->CanDoorSeeDoor(0, 1));
+		TestTrue(TEXT("Door 4 should see door 5"), RoomData->CanDoorSeeDoor(4, 5));
+		TestTrue(TEXT("Door 5 should see door 4 (second word)"), RoomData->CanDoorSeeDoor(5, 4));
+		TestFalse(TEXT("Door 5 should not see door 3 (second word)"), RoomData->CanDoorSeeDoor(5, 3));
+		TestTrue(TEXT("Invalid doors should always be seen"), RoomData->CanDoorSeeDoor(0, 6));
+
+		// The baked visibility is ignored once the doors have changed.
+		RoomData->Doors[2].Direction = EDoorDirection::East;
+		TestFalse(TEXT("Door visibility should be outdated"), RoomData->HasDoorVisibility());
+		TestTrue(TEXT("Door 0 should see door 1 when outdated"), RoomData->CanDoorSeeDoor(0, 1));
+	}
+
 	return true;
 }
 
@@ -0,0 +1,97 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#include "Utils/PortalCulling.h"
+
+namespace
+{
+	// Below this distance (in cm) the viewer is considered inside the portal, which can't narrow the view anymore.
+	constexpr float PortalPlaneTolerance = 1.0f;
+} //namespace
+
+FPortalFrustum::FPortalFrustum(const FVector& InOrigin, const FRotator& Rotation, float FieldOfView, float AspectRatio)
+	: Origin(InOrigin)
+{
+	const FRotationMatrix ViewMatrix(Rotation);
+	const FVector Forward = ViewMatrix.GetUnitAxis(EAxis::X);
+	const FVector Right = ViewMatrix.GetUnitAxis(EAxis::Y);
+	const FVector Up = ViewMatrix.GetUnitAxis(EAxis::Z);
+
+	const float HalfHorizontal = FMath::DegreesToRadians(FMath::Clamp(FieldOfView, 1.0f, 179.0f) * 0.5f);
+	const float HalfVertical = FMath::Atan(FMath::Tan(HalfHorizontal) / FMath::Max(AspectRatio, KINDA_SMALL_NUMBER));
+
+	const float SinH = FMath::Sin(HalfHorizontal);
+	const float CosH = FMath::Cos(HalfHorizontal);
+	const float SinV = FMath::Sin(HalfVertical);
+	const float CosV = FMath::Cos(HalfVertical);
+
+	const FVector Normals[] = {
+		Forward * SinH - Right * CosH, // Right
+		Forward * SinH + Right * CosH, // Left
+		Forward * SinV - Up * CosV, // Top
+		Forward * SinV + Up * CosV, // Bottom
+	};
+
+	for (const FVector& Normal : Normals)
+	{
+		Planes.Add(FPlane(Origin, Normal));
+	}
+}
+
+bool FPortalFrustum::IntersectsQuad(const FVector (&Corners)[4]) const
+{
+	for (const FPlane& Plane : Planes)
+	{
+		bool bAllOutside = true;
+		for (const FVector& Corner : Corners)
+		{
+			if (Plane.PlaneDot(Corner) >= 0.0f)
+			{
+				bAllOutside = false;
+				break;
+			}
+		}
+
+		if (bAllOutside)
+			return false;
+	}
+	return true;
+}
+
+FPortalFrustum FPortalFrustum::ClipThroughQuad(const FVector (&Corners)[4]) const
+{
+	FPortalFrustum Result(*this);
+
+	const FVector Center = 0.25f * (Corners[0] + Corners[1] + Corners[2] + Corners[3]);
+	FVector PortalNormal = FVector::CrossProduct(Corners[1] - Corners[0], Corners[2] - Corners[0]).GetSafeNormal();
+	float ViewerDistance = FVector::DotProduct(Center - Origin, PortalNormal);
+
+	// The viewer standing in the portal sees through it with the whole frustum.
+	if (PortalNormal.IsZero() || FMath::Abs(ViewerDistance) < PortalPlaneTolerance)
+		return Result;
+
+	// Only what is behind the portal is seen through it.
+	if (ViewerDistance < 0.0f)
+		PortalNormal = -PortalNormal;
+	Result.Planes.Add(FPlane(Center, PortalNormal));
+
+	// One plane for each edge, passing by the viewer.
+	for (int32 i = 0; i < 4; ++i)
+	{
+		const FVector& A = Corners[i];
+		const FVector& B = Corners[(i + 1) % 4];
+		FVector Normal = FVector::CrossProduct(A - Origin, B - Origin).GetSafeNormal();
+		if (Normal.IsZero())
+			continue;
+
+		if (FVector::DotProduct(Center - Origin, Normal) < 0.0f)
+			Normal = -Normal;
+		Result.Planes.Add(FPlane(Origin, Normal));
+	}
+
+	return Result;
+}
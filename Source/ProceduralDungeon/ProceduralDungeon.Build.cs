@@ -34,6 +34,7 @@ public class ProceduralDungeon : ModuleRules
 			"Engine",
 			"CoreUObject",
 			"NetCore",
+			"AssetRegistry",
 		});
 	}
 }
@@ -26,6 +26,9 @@ public:
 	ADoor();
 
 public:
+	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void PostNetReceive() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual bool ShouldTickIfViewportsOnly() const override { return true; }
 
@@ -45,9 +48,18 @@ public:
 
 	const UDoorType* GetDoorType() const { return Type; }
 
+	// Resets the door state when it is put back in the generator's door pool, before being reused at another place.
+	void Recycle();
+
 	bool ShouldBeOpened() const { return bShouldBeOpen; }
 	bool ShouldBeLocked() const { return bShouldBeLocked; }
 
+	// Updates the visibility, lock and open states of the door.
+	// It is called automatically when the connected rooms or the door are opened, locked, shown or hidden.
+	// Call it if you modify Always Visible or Always Unlocked at runtime.
+	UFUNCTION(BlueprintCallable, Category = "Door")
+	void UpdateDoorState();
+
 protected:
 	UFUNCTION()
 	virtual void OnDoorLock() {}
@@ -69,6 +81,13 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Door", meta = (DisplayName = "On Close"))
 	void OnDoorClose_BP();
 
+	// Called when the door is put back in the generator's door pool.
+	// Override it to reset any custom state of the door, as it will be reused by another room connection.
+	UFUNCTION()
+	virtual void OnDoorRecycled() {}
+	UFUNCTION(BlueprintImplementableEvent, Category = "Door", meta = (DisplayName = "On Recycled"))
+	void OnDoorRecycled_BP();
+
 protected:
 	bool bLocked {false};
 	bool bIsOpen {false};
@@ -10,6 +10,7 @@
 #include "CoreMinimal.h"
 #include "DungeonGeneratorBase.h"
 #include "BoundsParams.h"
+#include "QueueOrStack.h"
 #include "DungeonGenerator.generated.h"
 
 class IReadOnlyRoom;
@@ -26,8 +27,15 @@ public:
 protected:
 	//~ Begin ADungeonGeneratorBase Interface
 	virtual bool CreateDungeon_Implementation() override;
+	virtual bool ExpandDungeon_Implementation() override;
+	virtual bool IsDungeonCreationPending() const override;
+	virtual EGenerationResult ContinueDungeonCreation() override;
 	//~ End ADungeonGeneratorBase Interface
 
+	//~ Begin AActor Interface
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	//~ End AActor Interface
+
 public:
 	// ===== Methods that should be overriden in blueprint =====
 
@@ -99,11 +107,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Dungeon Generator")
 	void DiscardRoom() { bDiscardRoom = true; }
 
+protected:
+	// Returns false to prevent any new room to be placed at a door of a room.
+	// Used by subclasses to restrict the generation (e.g. to some regions of the dungeon).
+	virtual bool CanExpandDoor(const URoom& Room, int32 DoorIndex) const { return true; }
+
 private:
 	// Adds some new rooms linked to ParentRoom into Rooms list output
 	// AddedRooms contains only the new rooms added to Rooms list
+	// Only the door OnlyDoorIndex is used if not negative
 	// Returns true if the dungeon should keep adding new rooms
-	bool AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRooms);
+	bool AddNewRooms(URoom& ParentRoom, TArray<URoom*>& AddedRooms, int32 OnlyDoorIndex = -1);
+
+	// Makes one try to create a new room placed at NewRoomDoor.
+	// Returns null if the try failed, or if DiscardRoom has been called.
+	// DoorIndex is passed to ChooseNextRoomData, and is the door of the new room connected to the parent room.
+	URoom* TryCreateNextRoom(URoom& ParentRoom, const FDoorDef& DoorDef, const FDoorDef& NewRoomDoor, const FBoxMinAndMax& DungeonBounds, bool bCheckWorldCollision, const UWorld* World, int& DoorIndex);
+
+	// Returns false if the generation type is not supported.
+	bool GetListMode(TQueueOrStack<URoom*>::EMode& OutMode) const;
+
+	// ===== Time-sliced generation (used with asynchronous world collision checks) =====
+
+	// Starts a new generation try by placing the first room.
+	// The tries without a first room are skipped, returns false when there is no try left.
+	bool StartAsyncGenerationTry();
+
+	// Creates all the placement candidates of the next unconnected door of the current room,
+	// and requests their world collision checks.
+	// Returns true if we have to wait for the check results.
+	bool RequestNextDoorCandidates();
+
+	// Adds the first candidate not colliding with the world to the dungeon.
+	// Returns false if the check results are not available yet.
+	bool ResolveDoorCandidates();
+
+	// Discards all the time-sliced generation data.
+	void ResetAsyncGeneration();
 
 public:
 	// In which order the dungeon generate rooms.
@@ -127,4 +167,19 @@ public:
 
 	// Flag to explicitely tell we don't want to place a room.
 	bool bDiscardRoom = false;
+
+private:
+	TUniquePtr<TQueueOrStack<URoom*>> AsyncRoomStack;
+
+	UPROPERTY(Transient)
+	URoom* AsyncParentRoom {nullptr};
+
+	UPROPERTY(Transient)
+	TArray<URoom*> AsyncCandidates;
+
+	TArray<FTraceHandle> AsyncCandidateHandles;
+	TArray<int32> AsyncCandidateDoorIndices;
+	int32 AsyncDoorIndex {0};
+	int32 AsyncTriesLeft {0};
+	bool bAsyncShouldContinue {true};
 };
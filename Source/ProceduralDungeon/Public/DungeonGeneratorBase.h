@@ -13,6 +13,7 @@
 #include "DungeonOctree.h"
 #include "ProceduralDungeonTypes.h"
 #include "CollisionQueryParams.h"
+#include "WorldCollision.h"
 #include "UObject/ScriptInterface.h"
 #include "Serialization/Archive.h"
 #include "DungeonGeneratorBase.generated.h"
@@ -25,6 +26,8 @@ class ADoor;
 class URoom;
 class UDoorType;
 class UDungeonGraph;
+class ULevelStreamingDynamic;
+class UStaticMeshComponent;
 
 UENUM()
 enum class EGenerationResult : uint8
@@ -40,7 +43,8 @@ enum class EGeneratorFlags
 	None				= 0,
 	Generating			= 1 << 0,
 	LoadSavedDungeon	= 1 << 1,
-	All					= 0b11 // add new 1 for each new flags
+	Incremental			= 1 << 2,
+	All					= 0b111 // add new 1 for each new flags
 };
 ENUM_CLASS_FLAGS(EGeneratorFlags);
 
@@ -88,11 +92,31 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Dungeon Generator")
 	void Generate();
 
+	// Add new rooms to the current dungeon (by calling ExpandDungeon) without reloading the existing rooms.
+	// Only the new rooms will be replicated and loaded.
+	// Generate a new dungeon instead if there is no dungeon yet.
+	// Do nothing when called on clients or if a generation is already in progress.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Dungeon Generator")
+	void Grow();
+
+	// Remove all the rooms reachable from a door of the root room (without passing through the root room),
+	// then generate a new branch from this door with a new seed (by calling ExpandDungeon).
+	// Only the removed rooms are unloaded, and only the new ones are loaded.
+	// Do nothing when called on clients or if a generation is already in progress.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Dungeon Generator")
+	void RegenerateBranch(URoom* Root, int32 DoorIndex);
+
 	// Unload the current dungeon
 	// Do nothing when called on clients
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Dungeon Generator")
 	void Unload();
 
+	// Start loading asynchronously the assets used by the levels of the room data (from the asset registry dependencies),
+	// so they are already in memory when the rooms are instantiated. The levels themselves are still loaded with the rooms.
+	// The packages are kept loaded until the next dungeon is fully loaded.
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generator")
+	void PreloadRoomLevels(const TArray<URoomData*>& RoomDataList);
+
 	// Create a saved data from the current dungeon state
 	UFUNCTION(BlueprintPure = false, Category = "Dungeon Generator")
 	void SaveDungeon(FDungeonSaveData& SaveData);
@@ -128,6 +152,12 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "Dungeon Generator")
 	APawn* GetVisibilityPawn();
 
+	// Returns all the pawns used for the room culling system (e.g. the pawns of each local player in split-screen).
+	// The visible rooms are the union of the rooms visible from each pawn.
+	// By default returns the Visibility Pawn and the pawns (or spectators) of the other local player controllers.
+	UFUNCTION(BlueprintNativeEvent, Category = "Dungeon Generator")
+	void GetVisibilityPawns(TArray<APawn*>& OutPawns);
+
 	// ===== Optional events =====
 
 	// Called once before anything else when generating a new dungeon.
@@ -237,6 +267,31 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, Category = "GenerationAlgorithm")
 	bool CreateDungeon();
 
+	// Add new rooms to the existing dungeon (no load nor initialization of room levels)
+	// The existing rooms must not be modified, except to connect them with the new rooms.
+	// Only the new rooms have to be initialized (e.g. by calling Rooms->InitRooms with them).
+	UFUNCTION(BlueprintNativeEvent, Category = "GenerationAlgorithm")
+	bool ExpandDungeon();
+
+	// Returns true when CreateDungeon has started a creation that needs more frames to finish.
+	// While true, ContinueDungeonCreation is called each frame in the Generation state.
+	virtual bool IsDungeonCreationPending() const { return false; }
+
+	// Continues a time-sliced dungeon creation.
+	// Returns None while the creation is not finished, otherwise its final result.
+	virtual EGenerationResult ContinueDungeonCreation() { return EGenerationResult::Success; }
+
+	bool IsGenerating() const { return EnumHasAllFlags(Flags, EGeneratorFlags::Generating); }
+	bool IsLoadingSavedDungeon() const { return EnumHasAllFlags(Flags, EGeneratorFlags::LoadSavedDungeon); }
+	bool IsIncremental() const { return EnumHasAllFlags(Flags, EGeneratorFlags::Incremental); }
+
+	// Reinitializes the random stream with a sub-seed (e.g. to generate a part of the dungeon independently).
+	void InitializeRandomStream(int32 NewSeed) { Random.Initialize(NewSeed); }
+
+	// Returns true if ExpandDungeon is called to regenerate a branch of the dungeon.
+	// In that case, only the door DoorIndex of the Root room should be expanded.
+	bool GetBranchToRegenerate(URoom*& OutRoot, int32& OutDoorIndex) const;
+
 	// ===== Functions for dungeon creation =====
 
 	// Clear current graph and call GenerationInit event.
@@ -260,7 +315,24 @@ protected:
 	bool AddRoomToDungeon(URoom* const& Room, const TArray<int>& DoorsToConnect, bool bFailIfNotConnected = true);
 	bool AddRoomToDungeon(URoom* const& Room);
 
+	// Same as the blueprint version, but with explicit control on the world collision check.
+	bool TryPlaceRoom(URoom* const& Room, int DoorIndex, const FDoorDef& TargetDoor, bool bCheckWorldCollision, const UWorld* World) const;
+
+	// Issues an asynchronous world collision check for the current placement of the room.
+	// The result will be available in the next frame with GetWorldCollisionResult.
+	FTraceHandle RequestWorldCollisionCheck(const URoom* Room) const;
+
+	// Returns false if the result of the asynchronous check is not available yet.
+	// If the request has expired, a synchronous check is made instead.
+	bool GetWorldCollisionResult(const FTraceHandle& Handle, const URoom* Room, bool& bOutCollide) const;
+
 private:
+	// Calls the generation success or failed events at the end of the dungeon creation.
+	void EndDungeonCreation(bool bSuccess);
+
+	// Returns the world box used to check the room collision with the persistent world.
+	void GetWorldCollisionBox(const URoom* Room, FVector& OutCenter, FQuat& OutRotation, FCollisionShape& OutShape) const;
+
 	// Choose the door classes for all room connections.
 	// This must happen *after* Graph->InitRooms() to be able to choose door class for unconnected doors.
 	void ChooseDoorClasses();
@@ -268,17 +340,82 @@ private:
 	// Update the rooms visibility based on the player position
 	void UpdateRoomVisibility();
 
+	// Returns the rooms where the visibility pawns are.
+	void GetVisibilityPawnRooms(TSet<URoom*>& OutRooms);
+
+	// Fills VisibilityPawns with the valid pawns returned by GetVisibilityPawns.
+	void GatherVisibilityPawns();
+
+	// A camera view of a local player, used by the portal occlusion.
+	struct FVisibilityView
+	{
+		FVector Location {FVector::ZeroVector};
+		FRotator Rotation {FRotator::ZeroRotator};
+		float FOV {90.0f};
+		float AspectRatio {1.0f};
+	};
+
+	// Fills VisibilityViews with the camera views of the local players.
+	void GatherVisibilityViews();
+
+	// Adds the rooms seen from the view through the doors, up to MaxDepth rooms away from the rooms where the view is.
+	void GetRoomsInView(const FVisibilityView& View, uint32 MaxDepth, bool bClosedDoorsOcclude, TSet<URoom*>& OutRooms) const;
+
+	// Shows or hides the proxy mesh of a room, creating its component when needed.
+	void SetRoomProxyVisible(URoom* Room, bool bVisible);
+	void OnRoomProxyMeshLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+
+	// Destroys the proxy mesh components of the rooms.
+	void DestroyRoomProxy(URoom* Room);
+	void DestroyRoomProxies();
+
+	// Returns true when the rooms needed to start playing are initialized.
+	bool AreRoomsReadyToPlay();
+
+	// Continues to load in background the rooms not needed to start playing.
+	void UpdateBackgroundRoomLoading();
+
+	// Unloads the room levels too far from the players and loads the ones getting near them.
+	void UpdateRoomStreaming();
+
+	// Returns the rooms where the players are: the ones of UpdateRoomVisibility, and the remote players ones on server.
+	void GetPlayerRooms(TSet<URoom*>& OutRooms);
+
+	void RebuildNavmesh();
+
+	// Marks the area of the room (and its door seams with the neighbour rooms) to be rebuilt in the navmesh.
+	void AddNavmeshDirtyRoom(const URoom* Room);
+
+	// Garbage collects the unloaded room levels, depending on the plugin's settings.
+	void CollectUnloadedLevels();
+
+	// Unloads the pooled level instances not reused by the current dungeon.
+	void UnloadLevelInstancePool();
+
+	// Destroys the pooled doors not reused by the current dungeon.
+	void DestroyDoorPool();
+
+	void PreloadRoomLevel(const URoomData* Data);
+	void OnRoomLevelPreloaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+
+	// Releases the references to the preloaded assets, so they can be garbage collected.
+	void ReleasePreloadedRoomLevels();
+
 	// Reset all data from a specific generation
 	void Reset();
 
-	// Clear and refill octree from the dungeon graph
+	// Adds the new rooms of the dungeon graph in the octree and updates the moved ones
 	void UpdateOctree();
 
+	// Adds the room in the octree, or moves it if its bounds have changed
+	void AddRoomToOctree(URoom* Room);
+
+	// Removes the room from the octree, if it is in it
+	void RemoveRoomFromOctree(URoom* Room);
+
 	// Initialize the seed depending on the seed type setting
 	void UpdateSeed();
 
-	bool IsGenerating() const { return EnumHasAllFlags(Flags, EGeneratorFlags::Generating); }
-	bool IsLoadingSavedDungeon() const { return EnumHasAllFlags(Flags, EGeneratorFlags::LoadSavedDungeon); }
 
 	void DrawDebug() const;
 
@@ -314,6 +451,16 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = "Procedural Generation", AdvancedDisplay)
 	bool bUseWorldCollisionChecks {false};
 
+	// If ticked, the world collision checks of all placement candidates of a door are made asynchronously at once,
+	// and the generation continues in the next frame when the results are available.
+	// The generation is then spread over multiple frames instead of stalling the game thread on each check.
+	// Only supported by generators implementing a time-sliced creation (e.g. the default Dungeon Generator).
+	// Note that a same seed will not produce the same dungeon with and without this option:
+	// ChooseNextRoomData is called for all the placement tries of a door (Max Room Placement Try in the plugin settings) before the checks,
+	// even when the first room would fit, so its side effects run more times and the random stream is used differently.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = "Procedural Generation", AdvancedDisplay, meta = (EditCondition = "bUseWorldCollisionChecks"))
+	bool bUseAsyncWorldCollisionChecks {false};
+
 	UFUNCTION(BlueprintCallable, Category = "Dungeon Generator")
 	void SetSeed(int32 NewSeed);
 
@@ -330,6 +477,30 @@ public:
 	FORCEINLINE const UDungeonGraph* GetRooms() const { return Graph; }
 	FORCEINLINE EGenerationState GetCurrentState() const { return CurrentState; }
 
+	// Returns a pooled instance of the level moved to the provided transform, or null if none is available.
+	ULevelStreamingDynamic* AcquireLevelInstance(const TSoftObjectPtr<UWorld>& Level, const FTransform& Transform);
+
+	// Hides the level instance and keeps it in the pool to be reused by another room.
+	// Returns false if the instance can't be pooled, and thus must be unloaded.
+	bool ReleaseLevelInstance(const TSoftObjectPtr<UWorld>& Level, ULevelStreamingDynamic* Instance);
+
+	// Returns a pooled door of the exact class moved to the provided transform, or null if none is available.
+	ADoor* AcquireDoor(TSubclassOf<ADoor> DoorClass, const FTransform& Transform);
+
+	// Recycles and hides the door, and keeps it in the pool to be reused by another room connection.
+	// Returns false if the door can't be pooled, and thus must be destroyed.
+	bool ReleaseDoor(ADoor* Door);
+
+	// Called by the rooms when their state changes, to track the generation progress without checking all the rooms each frame.
+	void NotifyRoomReady(const URoom* Room);
+	void NotifyRoomLoaded(const URoom* Room);
+	void NotifyRoomInitialized(const URoom* Room);
+	void NotifyRoomUnloaded(const URoom* Room);
+	void NotifyRoomConnectionsChanged(const URoom* Room);
+
+	// Called by the doors when they are opened or closed, because they can hide the rooms behind them.
+	void NotifyDoorOpenChanged(const ADoor* Door);
+
 protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Dungeon Generator", meta = (DisplayName = "Rooms", ExposeFunctionCategories = "Dungeon Graph"))
 	UDungeonGraph* Graph;
@@ -360,6 +531,44 @@ private:
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation", meta = (AllowPrivateAccess = true))
 	bool bRebuildNavmesh {true};
 
+	// If true, only the navmesh tiles overlapping the loaded and unloaded rooms are rebuilt, instead of the whole navigable area.
+	// The rooms are slightly extended so the tiles at the doors between rooms are rebuilt too.
+	// Requires a navmesh with a dynamic runtime generation.
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation", meta = (AllowPrivateAccess = true, EditCondition = "bRebuildNavmesh"))
+	bool bRebuildNavmeshInRoomsOnly {false};
+
+	// Maximum number of room levels being loaded at the same time (0 means no limit).
+	// The rooms are loaded by order of distance from the player (or from the first room).
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true, ClampMin = 0))
+	int32 MaxConcurrentRoomLoads {0};
+
+	// Maximum number of doors spawned in a single frame (0 means no limit).
+	// The doors are spawned by order of distance from the player (or from the first room).
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true, ClampMin = 0))
+	int32 MaxDoorSpawnsPerFrame {0};
+
+	// The dungeon is ready to play (Post Generation is called) when all the rooms at this distance or less from the player are initialized.
+	// The distance is the number of room connections, not a distance in any unit.
+	// The remaining rooms are then loaded in background.
+	// Use a negative value to wait for all the rooms to be initialized.
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true))
+	int32 PlayableRoomDistance {-1};
+
+	// When positive or zero, only the rooms at this distance or less from the players have their level loaded.
+	// The rooms farther than this distance plus one are fully unloaded, and their saved actors are restored when loaded again.
+	// The distance is the number of room connections, not a distance in any unit.
+	// Should be greater than the occlusion distance to not see the rooms popping.
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true))
+	int32 StreamingDistance {-1};
+
+	// If ticked, the room levels unloaded by a new generation are kept hidden and reused by the rooms of the next dungeon using the same level,
+	// instead of being loaded again from the disk. The levels not reused are unloaded once the new dungeon is loaded.
+	// The actors of a reused level keep their state, but their BeginPlay is called again.
+	// Override On Recycled in the room level blueprint to reset their state when the level is released.
+	// Only used in standalone games, because the level instance names must match between the server and the clients.
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true))
+	bool bReuseRoomLevels {false};
+
 	EGenerationState CurrentState {EGenerationState::Idle};
 	EGeneratorFlags Flags {EGeneratorFlags::None};
 
@@ -370,15 +579,101 @@ private:
 	TUniquePtr<FDungeonOctree> Octree;
 	TSet<URoom*> CurrentPlayerRooms;
 
+	// Transient. The rooms made visible by the occlusion culling.
+	TSet<URoom*> VisibleRooms;
+
+	// Transient. True when the room visibilities must be computed again even if the player rooms did not change.
+	bool bIsVisibilityDirty {true};
+
+	// Transient. The pawns returned by GetVisibilityPawns, kept to reuse the allocation.
+	TArray<APawn*> VisibilityPawns;
+
+	// Transient. Used to skip the visibility update while none of the visibility pawns move.
+	TArray<TWeakObjectPtr<APawn>> PreviousVisibilityPawns;
+	TArray<FVector> PreviousVisibilityPawnLocations;
+
+	// Transient. The camera views of the local players.
+	TArray<FVisibilityView> VisibilityViews;
+
+	// Transient. Used to skip the portal occlusion update while none of the camera views move.
+	TArray<FVisibilityView> PreviousVisibilityViews;
+
 	// Transient. Only used to detect when occlusion setting is changed.
 	bool bWasOcclusionEnabled {false};
 
 	// Transient. Only used to detect when occlusion distance is changed.
 	uint32 PreviousOcclusionDistance {0};
 
+	// Transient. Only used to detect when occlusion proxy distance is changed.
+	uint32 PreviousOcclusionProxyDistance {0};
+
+	// Transient. The rooms showing their proxy mesh.
+	TSet<URoom*> ProxyRooms;
+
+	// The proxy mesh components of the rooms, kept hidden when the rooms leave ProxyRooms.
+	UPROPERTY(Transient)
+	TMap<URoom*, UStaticMeshComponent*> RoomProxies;
+
+	// Transient. Only used to detect when portal occlusion settings are changed.
+	bool bWasPortalOcclusionEnabled {false};
+	bool bDidClosedDoorsOcclude {false};
+
 	// Transient. Used to count unloaded/loaded/initialized rooms during generation.
 	int32 CachedTmpRoomCount {0};
 
+	// Transient. Number of rooms needed to be initialized to finish the Load state.
+	int32 CachedTmpRoomTotal {0};
+
+	// Transient. Number of spawned doors, and of doors needed to be spawned to finish the Load state.
+	int32 CachedTmpDoorCount {0};
+	int32 CachedTmpDoorTotal {0};
+
+	// Transient. True while some rooms are still loaded after the Load state.
+	bool bIsLoadingRoomsInBackground {false};
+
+	// Transient. The player rooms the streamed rooms have been computed from.
+	TSet<URoom*> StreamingPlayerRooms;
+
+	// Transient. True when the streamed rooms must be computed again even if the player rooms have not changed.
+	bool bIsRoomStreamingDirty {true};
+
 	// Transient. Cached collision params used when bUseWorldCollisionChecks is true
 	FCollisionQueryParams WorldCollisionParams;
+
+	// If ticked, the doors removed by a new generation are kept hidden and reused by the next dungeon for the doors of the same class,
+	// instead of being destroyed and spawned again. The doors not reused are destroyed once the new dungeon is loaded.
+	// Use the door's On Recycled event to reset its custom state.
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true))
+	bool bReuseDoors {false};
+
+	// If ticked, the assets used by the level of each room are loaded asynchronously as soon as the room is added to the dungeon,
+	// so the loading from the disk overlaps the rest of the generation.
+	// Uses the asset registry dependencies, so the packaged game must keep them in its asset registry.
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Procedural Generation|Streaming", meta = (AllowPrivateAccess = true))
+	bool bPreloadRoomLevels {false};
+
+	// Transient. Level packages and their dependencies requested by PreloadRoomLevel.
+	TSet<FName> PreloadingRoomLevels;
+
+	// Keep the assets of the preloaded dependency packages in memory until the rooms are loaded.
+	// The packages alone are not enough, since the cooked assets are not standalone objects.
+	UPROPERTY(Transient)
+	TArray<UObject*> PreloadedRoomAssets;
+
+	// Transient. World areas of the rooms loaded or unloaded since the last navmesh rebuild.
+	TArray<FBox> NavmeshDirtyAreas;
+
+	// Transient. Hidden level instances available for reuse, by level asset.
+	TMap<FSoftObjectPath, TArray<TWeakObjectPtr<ULevelStreamingDynamic>>> LevelInstancePool;
+
+	// Transient. Hidden doors available for reuse, by door class.
+	TMap<UClass*, TArray<TWeakObjectPtr<ADoor>>> DoorPool;
+
+	// The room and door from which a branch is regenerated.
+	UPROPERTY(Transient)
+	URoom* BranchRoot {nullptr};
+	int32 BranchDoorIndex {-1};
+
+	// Used to get a new seed each time a branch is regenerated.
+	int32 BranchRegenerationCount {0};
 };
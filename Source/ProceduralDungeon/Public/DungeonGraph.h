@@ -23,6 +23,7 @@ class URoomData;
 class URoomCustomData;
 class URoomConnection;
 class ADungeonGeneratorBase;
+class ADoor;
 
 // Describe a potential room to be added to the dungeon.
 // Mainly used by FilterAndSortRooms function.
@@ -79,8 +80,21 @@ public:
 
 	void AddRoom(URoom* Room);
 	void InitRooms();
+	// Creates the empty connections and initializes only the provided rooms (e.g. the rooms added when growing a dungeon).
+	void InitRooms(const TArray<URoom*>& RoomsToInit);
 	void Clear();
 
+	// Removes the rooms from the dungeon, without unloading them.
+	// Connections with the remaining rooms are replaced by empty connections.
+	// The removed rooms will be unloaded by the next UnloadRemovedRooms or UnloadAllRooms.
+	void RemoveRooms(const TArray<URoom*>& RoomsToRemove);
+
+	// Returns all the rooms reachable from a door of the root room without passing through the root room.
+	void GetBranchRooms(const URoom* Root, int32 DoorIndex, TArray<URoom*>& OutRooms) const;
+
+	// Returns a room ID not used by any room of the dungeon yet.
+	int32 GetNextRoomId() const { return NextRoomId; }
+
 	bool TryConnectDoor(URoom* Room, int32 DoorIndex);
 	bool TryConnectToExistingDoors(URoom* Room);
 
@@ -208,6 +222,24 @@ public:
 	// Distance is the number of room connection between 2 rooms, not the distance in any unit.
 	static void TraverseRooms(const TSet<URoom*>& InRooms, TSet<URoom*>* OutRooms, uint32 Distance, TFunction<void(URoom*)> Func);
 
+	// Same as TraverseRooms, but uses a table of the rooms in the Distance of each room of the dungeon.
+	// The table is computed on the first call for each Distance and kept until the dungeon changes,
+	// so it is faster than TraverseRooms when called often (e.g. each time the player changes room).
+	void GetRoomsInDistance(const TSet<URoom*>& InRooms, uint32 Distance, TSet<URoom*>& OutRooms) const;
+
+	// Same as GetRoomsInDistance, but keeps only the rooms potentially visible from InRooms through the doors in the Distance.
+	// Uses the door visibility baked in the room data, the rooms without it can see through all their doors.
+	// When no room data has a door visibility baked, it just returns the rooms of GetRoomsInDistance.
+	void GetVisibleRoomsInDistance(const TSet<URoom*>& InRooms, uint32 Distance, TSet<URoom*>& OutRooms) const;
+
+	// Clears the tables used by GetRoomsInDistance and GetVisibleRoomsInDistance.
+	void InvalidateRoomDistances();
+
+	// Adds in OutRooms the rooms occupying the cells overlapped by Box (in Unreal Units, relative to the dungeon).
+	// Uses a map of the occupied cells, built on the first call and kept until the dungeon changes.
+	// Returns false without adding any room if Box overlaps more than MaxCells cells.
+	bool GetRoomsInBox(const FBox& Box, TSet<URoom*>& OutRooms, int32 MaxCells = MAX_int32) const;
+
 	static bool FindPath(const URoom* From, const URoom* To, TArray<const URoom*>* OutPath = nullptr, bool IgnoreLocked = false);
 
 protected:
@@ -228,17 +260,83 @@ protected:
 	void RetrieveRoomsFromLoadedData();
 
 	// Create and store a new connection between two rooms in RoomConnections.
+	// Any empty connection already existing at those doors is removed first.
 	void Connect(URoom* RoomA, int32 DoorA, URoom* RoomB, int32 DoorB);
 
-	bool AreRoomsLoaded(int32& NbRoomLoaded) const;
+	// Removes a connection from RoomConnections and from its rooms (and destroys its door on server).
+	// The IDs of the remaining connections are not updated, CompactConnectionIDs must be called once all the connections are removed.
+	void RemoveConnection(URoomConnection* Connection);
+
+	// Sets the ID of each connection to its index in RoomConnections (used when saving/loading the dungeon).
+	void CompactConnectionIDs();
+
+	// Destroys a door actor, or gives it back to the generator's door pool.
+	void DestroyDoor(ADoor* Door) const;
+
+	// Returns true if the replicated room list still contains some of the current rooms.
+	// Used on clients to know if the dungeon has been updated incrementally (only some rooms added or removed).
+	bool IsIncrementalUpdate() const;
+
 	bool AreRoomsUnloaded(int32& NbRoomUnloaded) const;
-	bool AreRoomsInitialized(int32& NbRoomInitialized) const;
 	bool AreRoomsReady() const;
 
+	// Returns true if all the queued rooms within MaxDistance of the start rooms are initialized.
+	// NbRoomToInitialize is the number of those rooms.
+	bool AreNearRoomsInitialized(int32 MaxDistance, int32& NbRoomInitialized, int32& NbRoomToInitialize) const;
+
+	// Called by the generator when a room changes state.
+	// They keep the pending rooms up to date, so the generation states don't check all the rooms each frame.
+	void OnRoomReady(const URoom* Room);
+	void OnRoomLoaded(const URoom* Room);
+	void OnRoomInitialized(const URoom* Room);
+	void OnRoomUnloaded(const URoom* Room);
+
 	void SpawnAllDoors();
 	void LoadAllRooms();
+
+	// Queues the loading of all the rooms not loaded yet, ordered by their distance (number of connections) from the start rooms.
+	// The rooms are then instantiated progressively by UpdateRoomLoading.
+	// The rooms farther than MaxDistance are not queued (a negative value queues all the rooms).
+	void LoadAllRooms(const TSet<URoom*>& StartRooms, int32 MaxDistance = -1);
+
+	// Instantiates the next queued rooms while there are less than MaxLoadingRooms levels being loaded (0 means no limit).
+	void UpdateRoomLoading(int32 MaxLoadingRooms);
+
+	// Returns true while some queued rooms are not instantiated yet.
+	bool HasRoomsToLoad() const { return LoadQueueIndex < LoadQueue.Num(); }
+
+	// Queues the loading of a room after the ones already queued (e.g. a room streamed in by the generator).
+	// It is instantiated by UpdateRoomLoading, like the rooms queued by LoadAllRooms.
+	void QueueRoomLoad(URoom* Room);
+
+	// Removes the room from the load queue if it is not instantiated yet. It is not waited for anymore.
+	void CancelRoomLoad(const URoom* Room);
+
+	bool IsRoomLoadQueued(const URoom* Room) const { return QueuedRooms.Contains(Room); }
+
+	// Spawns the next queued doors, at most MaxSpawnedDoors (0 means no limit).
+	// The doors are queued by LoadAllRooms, ordered by the distance of their rooms from the start rooms.
+	void UpdateDoorSpawning(int32 MaxSpawnedDoors);
+
+	// Returns true while some queued doors are not spawned yet.
+	bool HasDoorsToSpawn() const { return DoorQueueIndex < DoorQueue.Num(); }
+
+	// Returns true if all the queued doors within MaxDistance of the start rooms are spawned.
+	// NbDoorToSpawn is the number of those doors.
+	bool AreNearDoorsSpawned(int32 MaxDistance, int32& NbDoorSpawned, int32& NbDoorToSpawn) const;
+
 	void UnloadAllRooms();
 
+	// Unloads only the rooms not part of the dungeon anymore.
+	// On clients, those are the rooms not in the replicated room list.
+	void UnloadRemovedRooms();
+
+	// Destroys the instances of UnloadingRooms and gathers the ones to wait for.
+	void DestroyUnloadingRooms();
+
+	// Returns the rooms being unloaded by the last UnloadAllRooms or UnloadRemovedRooms.
+	const TArray<URoom*>& GetUnloadingRooms() const { return UnloadingRooms; }
+
 	void MarkDirty() { bIsDirty = true; }
 
 	// Extends the bounds if necessary to include the provided room.
@@ -262,6 +360,55 @@ private:
 	UFUNCTION()
 	void OnRep_Rooms();
 
+	// The rooms removed from the dungeon and waiting to be unloaded.
+	UPROPERTY(Transient)
+	TArray<URoom*> RemovedRooms;
+
+	// The rooms currently being unloaded.
+	UPROPERTY(Transient)
+	TArray<URoom*> UnloadingRooms;
+
+	// Room IDs are never reused while the dungeon is not cleared, even when some rooms are removed.
+	int32 NextRoomId {0};
+
+	// The rooms to load, ordered by their distance from the start rooms.
+	UPROPERTY(Transient)
+	TArray<URoom*> LoadQueue;
+
+	// The distance from the start rooms of each room in LoadQueue.
+	TArray<int32> LoadQueueDistances;
+
+	// Index of the next room to instantiate in LoadQueue.
+	int32 LoadQueueIndex {0};
+
+	// The rooms of LoadQueue not instantiated yet, and not cancelled.
+	TSet<const URoom*> QueuedRooms;
+
+	// The rooms instantiated by UpdateRoomLoading whose level is still being loaded.
+	TSet<const URoom*> LoadingRooms;
+
+	// The connections with a door to spawn, ordered by the distance of their rooms from the start rooms.
+	UPROPERTY(Transient)
+	TArray<URoomConnection*> DoorQueue;
+
+	// The distance from the start rooms of each connection in DoorQueue.
+	TArray<int32> DoorQueueDistances;
+
+	// Index of the next door to spawn in DoorQueue.
+	int32 DoorQueueIndex {0};
+
+	// The rooms without their room data yet (only on clients, while it is not replicated).
+	TSet<const URoom*> PendingReadyRooms;
+
+	// The queued rooms not initialized yet, with their distance from the start rooms.
+	TMap<const URoom*, int32> PendingInitRooms;
+
+	// The distances from the start rooms of the queued rooms already initialized, sorted.
+	TArray<int32> InitializedDistances;
+
+	// The rooms being unloaded whose level is not unloaded yet.
+	TSet<const URoom*> PendingUnloadRooms;
+
 	bool bIsDirty {false};
 
 	// @TODO: Make something to decouple the ADungeonGenerator from the UDungeonGraph.
@@ -274,6 +421,57 @@ private:
 	// Transient. The computed bounds of the dungeon. Updated each time the room list changes.
 	FVoxelBounds Bounds;
 
+	// The rooms in a given distance of each room, stored as indices in the Rooms array.
+	struct FRoomDistanceTable
+	{
+		// Range of each room in RoomIndices, the rooms of Rooms[i] being from Offsets[i] to Offsets[i + 1] (excluded).
+		TArray<int32> Offsets;
+		TArray<int32> RoomIndices;
+	};
+
+	// Returns false if some connections are not replicated yet, in which case the table must not be kept.
+	bool BuildRoomDistanceTable(uint32 Distance, FRoomDistanceTable& OutTable) const;
+
+	// Returns the table of the rooms in Distance, built in TmpTable if it can't be kept yet.
+	const FRoomDistanceTable& GetRoomDistanceTable(uint32 Distance, FRoomDistanceTable& TmpTable) const;
+
+	// Same as BuildRoomDistanceTable, but with only the rooms potentially visible through the doors in the Distance.
+	// Returns false if some connections are not replicated yet, in which case the table must not be kept.
+	bool BuildVisibleRoomTable(uint32 Distance, FRoomDistanceTable& OutTable) const;
+
+	// Returns the table of the rooms potentially visible in Distance, built in TmpTable if it can't be kept yet.
+	const FRoomDistanceTable& GetVisibleRoomTable(uint32 Distance, FRoomDistanceTable& TmpTable) const;
+
+	// Returns true if a room data of the dungeon has a door visibility baked.
+	bool HasDoorVisibility() const;
+
+	// Fills RoomIndices if the rooms have changed since the last call.
+	void CacheRoomIndices() const;
+
+	// Fills the index in the Rooms array of the room occupying each cell.
+	// Returns false if some room data are not replicated yet, in which case the map must not be kept.
+	bool BuildRoomCells(TMap<FIntVector, int32>& OutCells) const;
+
+	// Adds the cells occupied by the room to the map.
+	static void AddRoomCells(const URoom* Room, int32 RoomIndex, TMap<FIntVector, int32>& OutCells);
+
+	// Returns RoomCells, building it first if needed.
+	// Uses TmpCells when some room data are not replicated yet.
+	const TMap<FIntVector, int32>& GetRoomCells(TMap<FIntVector, int32>& TmpCells) const;
+
+	// Transient. Tables of GetRoomsInDistance by distance, and the index of each room in the Rooms array.
+	mutable TMap<uint32, FRoomDistanceTable> RoomDistanceTables;
+	mutable TMap<const URoom*, int32> RoomIndices;
+
+	// Transient. Tables of GetVisibleRoomsInDistance by distance, and whether a room data has a door visibility baked.
+	mutable TMap<uint32, FRoomDistanceTable> VisibleRoomTables;
+	mutable bool bIsDoorVisibilityCached {false};
+	mutable bool bHasDoorVisibility {false};
+
+	// Transient. The room occupying each cell, empty until GetRoomAt or GetRoomsInBox is called.
+	// Unlike the other tables, it does not depend on the connections and is only cleared when the rooms change.
+	mutable TMap<FIntVector, int32> RoomCells;
+
 private:
 	struct FSaveData
 	{
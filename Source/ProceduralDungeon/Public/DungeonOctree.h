@@ -16,6 +16,13 @@
 	#define USE_LEGACY_OCTREE 0
 #endif
 
+using FDungeonOctreeElementId =
+#if USE_LEGACY_OCTREE
+	FOctreeElementId;
+#else
+	FOctreeElementId2;
+#endif
+
 struct FDungeonOctreeElement
 {
 	class URoom* Room;
@@ -42,14 +49,8 @@ struct FDungeonOctreeSemantics
 		return A.Room == B.Room;
 	}
 
-	FORCEINLINE static void SetElementId(const FDungeonOctreeElement& Element
-#if USE_LEGACY_OCTREE
-		, FOctreeElementId Id)
-#else
-		, FOctreeElementId2 Id)
-#endif
-	{
-	}
+	// Stores the id in the room, so it can be removed from the octree without a search.
+	static void SetElementId(const FDungeonOctreeElement& Element, FDungeonOctreeElementId Id);
 
 	FORCEINLINE static void ApplyOffset(FDungeonOctreeElement& Element, FVector Offset)
 	{
@@ -0,0 +1,102 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DungeonGenerator.h"
+#include "InfiniteDungeonGenerator.generated.h"
+
+// A dungeon generator that generates the dungeon lazily in regions around the players.
+// Each region is generated with its own seed, and the regions too far from the players are unloaded and forgotten.
+// A region depends on its seed and on the doors leading into it, so a forgotten region is generated again
+// with the same rooms only if the rooms around it are the same.
+// The rooms are chosen the same way as the Dungeon Generator (Choose First Room, Choose Next Room, etc.).
+// Is Valid Dungeon is only called after placing the first room, the regions are not validated.
+UCLASS(Blueprintable, ClassGroup = "Procedural Dungeon", HideCategories = "GenerationAlgorithm")
+class PROCEDURALDUNGEON_API AInfiniteDungeonGenerator : public ADungeonGenerator
+{
+	GENERATED_BODY()
+
+public:
+	AInfiniteDungeonGenerator();
+
+protected:
+	//~ Begin AActor Interface
+	virtual void Tick(float DeltaTime) override;
+	//~ End AActor Interface
+
+	//~ Begin ADungeonGeneratorBase Interface
+	virtual bool CreateDungeon_Implementation() override;
+	virtual bool ExpandDungeon_Implementation() override;
+	//~ End ADungeonGeneratorBase Interface
+
+	//~ Begin ADungeonGenerator Interface
+	virtual bool ContinueToAddRoom_Implementation() override;
+	virtual bool CanExpandDoor(const URoom& Room, int32 DoorIndex) const override;
+	//~ End ADungeonGenerator Interface
+
+public:
+	// Returns the region containing a room cell.
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generator|Infinite")
+	FIntVector GetRegionAt(FIntVector RoomCell) const;
+
+	// Returns the seed used to generate a region.
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generator|Infinite")
+	int32 GetRegionSeed(FIntVector Region) const;
+
+	// Returns true if the region has been generated and not forgotten since.
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generator|Infinite")
+	bool IsRegionGenerated(FIntVector Region) const { return GeneratedRegions.Contains(Region); }
+
+private:
+	// Removes the rooms of the far regions and requests the generation of the near ones.
+	void UpdateRegions();
+
+	// Returns the regions where the players are.
+	void GetPlayerRegions(TSet<FIntVector>& OutRegions) const;
+
+	// Fills PendingRegions with the regions not generated yet around the provided ones (including the empty ones).
+	void GatherPendingRegions(const TSet<FIntVector>& CenterRegions);
+
+	// Returns the distance (in number of regions) from the region to the nearest center region.
+	static int32 GetRegionDistance(const FIntVector& Region, const TSet<FIntVector>& CenterRegions);
+
+public:
+	// Size of a region in room units.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation|Infinite", meta = (ClampMin = 1))
+	FIntVector RegionSize {10, 10, 10};
+
+	// The regions at this distance (in number of regions) or less from a player are generated.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation|Infinite", meta = (ClampMin = 0))
+	int32 LoadDistance {1};
+
+	// The regions farther than this distance (in number of regions) from all players are unloaded and forgotten.
+	// Should be greater than LoadDistance to avoid regenerating the same regions when a player moves back and forth at a region border.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation|Infinite", meta = (ClampMin = 0))
+	int32 UnloadDistance {2};
+
+	// Time (in seconds) between two checks of the player regions.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation|Infinite", meta = (ClampMin = 0, Units = "s"))
+	float RegionUpdateInterval {0.5f};
+
+private:
+	// The regions generated and not forgotten yet.
+	TSet<FIntVector> GeneratedRegions;
+
+	// The regions where no room has been placed yet, because no door leads into them.
+	TSet<FIntVector> EmptyRegions;
+
+	// The regions to generate in the next ExpandDungeon.
+	TArray<FIntVector> PendingRegions;
+
+	// The region currently generated. Only the doors leading into this region are expanded.
+	FIntVector ExpandingRegion {0};
+	bool bIsExpandingRegion {false};
+
+	float TimeSinceRegionUpdate {0.0f};
+};
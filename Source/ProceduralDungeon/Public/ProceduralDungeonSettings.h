@@ -10,6 +10,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Engine/EngineTypes.h"
+#include "ProceduralDungeonTypes.h"
 #include "ProceduralDungeonSettings.generated.h"
 
 // Holds the plugin's settings.
@@ -58,6 +59,17 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "General", AdvancedDisplay, meta = (UIMin = 1, ClampMin = 1))
 	int32 RoomLimit;
 
+	// How the unloaded room levels are garbage collected at the end of the unload step of a generation.
+	// Blocking frees the memory right away but stalls the game thread (and all the sessions hosted by a server process).
+	// The other modes avoid the stall, but the new room levels having the same name as unloaded ones (e.g. with a fixed seed)
+	// will wait for the old ones to be collected before being loaded.
+	UPROPERTY(EditAnywhere, config, Category = "General", AdvancedDisplay)
+	EUnloadGarbageCollection UnloadGarbageCollection {EUnloadGarbageCollection::Blocking};
+
+	// Time (in seconds) between two updates of the rooms of the actors registered in the Room Visitor Subsystem.
+	UPROPERTY(EditAnywhere, config, Category = "General", AdvancedDisplay, meta = (UIMin = 0.01, ClampMin = 0.01, Units = "s"))
+	float RoomVisitorUpdateInterval;
+
 	// The rooms visibility will be toggled off when the player is not inside it or in a room next to it.
 	UPROPERTY(EditAnywhere, config, Category = "Occlusion Culling", meta = (DisplayName = "Enable Occlusion Culling"))
 	bool OcclusionCulling;
@@ -71,6 +83,20 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Occlusion Culling", meta = (EditCondition = "OcclusionCulling", UIMin = 1, ClampMin = 1))
 	int32 OcclusionDistance;
 
+	// Number of rooms beyond the Occlusion Distance showing their proxy mesh (set in their room data) instead of being fully hidden.
+	// 0 means no proxy mesh is shown.
+	UPROPERTY(EditAnywhere, config, Category = "Occlusion Culling", meta = (EditCondition = "OcclusionCulling", UIMin = 0, ClampMin = 0))
+	int32 OcclusionProxyDistance;
+
+	// Use the doors as portals: only the rooms seen from the player's camera through the doors are visible.
+	// The Occlusion Distance is still the maximum number of doors the camera can see through.
+	UPROPERTY(EditAnywhere, config, Category = "Occlusion Culling", meta = (EditCondition = "OcclusionCulling"))
+	bool PortalOcclusion;
+
+	// With the portal occlusion, the rooms are not seen through the closed doors.
+	UPROPERTY(EditAnywhere, config, Category = "Occlusion Culling", meta = (EditCondition = "OcclusionCulling && PortalOcclusion"))
+	bool ClosedDoorsOcclude;
+
 	// Keep track of dynamic actors entering and leaving the room to be able to show/hide them with the room.
 	// TODO: Still useful? It was there for performance issues, but there is none anymore...
 	// Maybe moving it in a console variable only for debug purpose?
@@ -81,6 +81,16 @@ enum class ESeedType : uint8
 	NbType = 3 				UMETA(Hidden)
 };
 
+// How the unloaded room levels are garbage collected before generating a new dungeon.
+UENUM(BlueprintType, meta = (DisplayName = "Unload Garbage Collection"))
+enum class EUnloadGarbageCollection : uint8
+{
+	Blocking = 0 			UMETA(DisplayName = "Blocking", Tooltip = "Flush the level streaming and force a full purge (blocks the game thread)"),
+	Incremental = 1 		UMETA(DisplayName = "Incremental", Tooltip = "Request a garbage collection with an incremental purge over the next frames"),
+	Deferred = 2 			UMETA(DisplayName = "Deferred", Tooltip = "Let the engine collect the unloaded levels in its next periodic garbage collection"),
+	NbType = 3 				UMETA(Hidden)
+};
+
 // Visibility mode for Room Visibilty Components.
 UENUM(BlueprintType, meta = (DisplayName = "Room Visibility"))
 enum class EVisibilityMode : uint8
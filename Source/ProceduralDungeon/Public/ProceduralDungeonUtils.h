@@ -27,6 +27,7 @@ namespace IntVector
 
 class FBoxCenterAndExtent;
 struct FBoxMinAndMax;
+enum class EUnloadGarbageCollection : uint8;
 
 namespace Dungeon
 {
@@ -87,6 +88,9 @@ namespace Dungeon
 	bool PROCEDURALDUNGEON_API OcclusionCulling();
 	bool PROCEDURALDUNGEON_API UseLegacyOcclusion();
 	uint32 PROCEDURALDUNGEON_API OcclusionDistance();
+	uint32 PROCEDURALDUNGEON_API OcclusionProxyDistance();
+	bool PROCEDURALDUNGEON_API PortalOcclusion();
+	bool PROCEDURALDUNGEON_API ClosedDoorsOcclude();
 	bool PROCEDURALDUNGEON_API OccludeDynamicActors();
 	bool PROCEDURALDUNGEON_API DrawDebug();
 	bool PROCEDURALDUNGEON_API DrawOnlyWhenEditingRoom();
@@ -99,6 +103,8 @@ namespace Dungeon
 	uint32 PROCEDURALDUNGEON_API MaxGenerationTryBeforeGivingUp();
 	uint32 PROCEDURALDUNGEON_API MaxRoomPlacementTryBeforeGivingUp();
 	int32 PROCEDURALDUNGEON_API RoomLimit();
+	EUnloadGarbageCollection PROCEDURALDUNGEON_API UnloadGarbageCollection();
+	float PROCEDURALDUNGEON_API RoomVisitorUpdateInterval();
 
 	void PROCEDURALDUNGEON_API EnableOcclusionCulling(bool Enable);
 	void PROCEDURALDUNGEON_API SetOcclusionDistance(int32 Distance);
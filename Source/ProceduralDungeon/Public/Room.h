@@ -17,6 +17,7 @@
 #include "RoomData.h" // for TSoftObjectPtr to compile. @TODO: Would be great to find a way to not include it
 #include "ReadOnlyRoom.h"
 #include "VoxelBounds/VoxelBounds.h"
+#include "DungeonOctree.h"
 #include "Room.generated.h"
 
 class ADungeonGeneratorBase;
@@ -182,6 +183,10 @@ private:
 	bool bIsVisible {true};
 	bool bForceVisible {false};
 
+	// Transient. Id of the room element in the octree of the generator, invalid when not in it.
+	FDungeonOctreeElementId OctreeElementId;
+	friend struct FDungeonOctreeSemantics;
+
 	UPROPERTY(ReplicatedUsing = OnRep_IsLocked, SaveGame)
 	bool bIsLocked {false};
 
@@ -212,16 +217,36 @@ protected:
 	UFUNCTION() // needed macro for binding to delegate
 	void OnInstanceLoaded();
 
+	UFUNCTION() // needed macro for binding to delegate
+	void OnInstanceUnloaded();
+
+	// Updates the state of the doors of this room (visibility, lock, etc.).
+	void UpdateDoors() const;
+
 public:
 	void Init(URoomData* RoomData, ADungeonGeneratorBase* Generator, int32 RoomId);
 
 	void Instantiate(UWorld* World);
 	void Destroy();
+
+	// Saves the state of the room actors then unloads the room instance.
+	// The state is restored when the room is instantiated again.
+	void StreamOut();
+	bool IsStreamedOut() const { return StreamingData.IsValid(); }
+
+	// Called by the level script once the room instance has begun play.
+	void OnInstanceInitialized();
+
 	ARoomLevel* GetLevelScript() const;
 	bool IsInstanceLoaded() const;
 	bool IsInstanceUnloaded() const;
 	bool IsInstanceInitialized() const;
 	void CreateLevelComponents(ARoomLevel* LevelActor);
+	void DestroyLevelComponents();
+
+	// Id of the room in the octree of the generator, set by the octree itself when the room is added.
+	const FDungeonOctreeElementId& GetOctreeElementId() const { return OctreeElementId; }
+	void ClearOctreeElementId() { OctreeElementId = FDungeonOctreeElementId(); }
 
 	EDoorDirection GetDoorWorldOrientation(int DoorIndex) const;
 	FIntVector GetDoorWorldPosition(int DoorIndex) const;
@@ -229,6 +254,8 @@ public:
 	int32 GetConnectionCount() const { return Connections.Num(); }
 	bool IsConnected(int32 DoorIndex) const;
 	void SetConnection(int32 DoorIndex, URoomConnection* Conn);
+	void ClearConnection(int32 DoorIndex);
+	URoomConnection* GetConnection(int32 DoorIndex) const;
 	TWeakObjectPtr<URoom> GetConnectedRoom(int32 DoorIndex) const;
 	int32 GetFirstEmptyConnection() const;
 	void GetAllEmptyConnections(TArray<int32>& EmptyConnections) const;
@@ -291,6 +318,9 @@ private:
 	// This is a unique ptr so we have a data only when we need it.
 	TUniquePtr<FSaveData> SaveData {nullptr};
 
+	// Actors state kept while the room instance is unloaded, restored in OnInstanceInitialized.
+	TUniquePtr<FSaveData> StreamingData {nullptr};
+
 	bool SerializeLevelActors(FSaveData& Data, bool bIsLoading);
 	void DispatchCallbackToSavedLevelActors(TFunction<void(AActor*)> Callback) const;
 };
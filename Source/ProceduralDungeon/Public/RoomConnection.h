@@ -36,6 +36,7 @@ public:
 public:
 	UFUNCTION(BlueprintPure, Category = "Room Connection")
 	int32 GetID() const;
+	void SetID(int32 NewID);
 
 	const TWeakObjectPtr<URoom> GetRoomA() const;
 	const TWeakObjectPtr<URoom> GetRoomB() const;
@@ -23,6 +23,7 @@ class PROCEDURALDUNGEON_API URoomCustomData : public UReplicableObject, public I
 
 public:
 	void CreateLevelComponent(class ARoomLevel* LevelActor);
+	void DestroyLevelComponent();
 
 	//~ Begin IDungeonCustomSerialization Interface
 	virtual bool SerializeObject(FStructuredArchive::FRecord& Record, bool bIsLoading) override;
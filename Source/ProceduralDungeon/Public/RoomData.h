@@ -69,10 +69,28 @@ class PROCEDURALDUNGEON_API URoomData : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FRoomDataTests;
+	friend class FDungeonGraphTest;
+#endif
+
 public:
 	UPROPERTY(EditInstanceOnly, Category = "Level")
 	TSoftObjectPtr<UWorld> Level {nullptr};
 
+	// Optional stripped version of the level (gameplay logic and collisions only) loaded instead of Level on dedicated servers.
+	// Its level blueprint must derive from RoomLevel and reference this room data too.
+	// It must be in the same folder as Level, so the room instances get the same package path on the server and the clients.
+	// Its world keeps its own name though, so the replicated actors placed in it can't be matched with the clients:
+	// spawn the replicated actors at runtime instead (e.g. from the level blueprint).
+	UPROPERTY(EditInstanceOnly, Category = "Level")
+	TSoftObjectPtr<UWorld> ServerLevel {nullptr};
+
+	// Optional low-cost mesh (e.g. the level meshes merged together) shown instead of the level when the room is just beyond the occlusion distance.
+	// It can be generated from the room editor mode.
+	UPROPERTY(EditInstanceOnly, Category = "Level")
+	TSoftObjectPtr<UStaticMesh> ProxyMesh {nullptr};
+
 public:
 	// This will force a random door to be chosen during the dungeon generation.
 	// DEPRECATED: It will be removed in a future version of the plugin. As a replacement, you should return -1 as DoorIndex in the ChooseNextRoomData of your DungeonGenerator.
@@ -96,9 +114,22 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Room")
 	TSet<TSubclassOf<URoomCustomData>> CustomData;
 
+private:
+	// Which doors can be seen from each door through the room, baked from the room level in the editor mode.
+	// The bit (A * DoorCount + B) is set when the door B can be seen from the door A.
+	UPROPERTY()
+	TArray<uint32> DoorVisibility;
+
+	// The doors when the door visibility has been baked, to ignore it when the doors have changed since.
+	UPROPERTY()
+	TArray<FDoorDef> DoorVisibilityDoors;
+
 public:
 	URoomData();
 
+	// Returns the level to instantiate in the world: the Server Level on dedicated servers when set, the Level otherwise.
+	const TSoftObjectPtr<UWorld>& GetLevelToLoad(const UWorld* World) const;
+
 	UFUNCTION(BlueprintPure, Category = "Room Data", meta = (DisplayName = "Door Count", CompactNodeTitle = "Door Count"))
 	int GetNbDoor() const { return Doors.Num(); }
 
@@ -147,6 +178,13 @@ public:
 
 	bool IsRoomInBounds(const FBoxMinAndMax& Bounds, int DoorIndex, const FDoorDef& DoorDungeonPos) const;
 
+	// Returns true if the door visibility has been baked with the current doors.
+	bool HasDoorVisibility() const;
+
+	// Returns true if the door ToDoor may be seen from the door FromDoor through the room.
+	// Always true when the door visibility has not been baked.
+	bool CanDoorSeeDoor(int32 FromDoor, int32 ToDoor) const;
+
 	int32 GetPointIndex() const;
 	void SetPointInfo(int32 PointIndex, FTransform Transform);
 	void RemovePointInfo(int32 PointIndex);
@@ -168,6 +206,11 @@ public:
 	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
 	#endif // USE_LEGACY_DATA_VALIDATION
 
+	// Computes which doors can see each other through the room, by tracing lines between the doors in the room level.
+	// The world must be the one where the room level is opened.
+	void BakeDoorVisibility(const UWorld* World);
+	void ClearDoorVisibility();
+
 	FRoomDataEditorEvent OnPropertiesChanged;
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 	
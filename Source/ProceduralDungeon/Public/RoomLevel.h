@@ -53,6 +53,9 @@ public:
 	void Init(URoom* Room);
 	void SetActorsVisible(bool Visible);
 
+	// Called by the generator when the level is put back in its level pool.
+	void Recycle();
+
 	FORCEINLINE bool IsInit() const { return bIsInit; }
 
 	UFUNCTION(BlueprintPure, Category = "Procedural Dungeon", meta = (CompactNodeTitle = "Is Player Inside", DeprecatedFunction, DeprecationMessage = "Use GetRoom() instead to access directly the room functions."))
@@ -82,6 +85,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Procedural Dungeon")
 	FVector GetBoundsExtent() const;
 
+protected:
+	// Called when the level is put back in the generator's level pool (see Reuse Room Levels in the generator).
+	// Override it to reset the state of the level actors, as the level will be reused by another room.
+	UFUNCTION()
+	virtual void OnRoomLevelRecycled() {}
+	UFUNCTION(BlueprintImplementableEvent, Category = "Procedural Dungeon", meta = (DisplayName = "On Recycled"))
+	void OnRoomLevelRecycled_BP();
+
 public:
 	// Event to notify when the visibility of the room has been toggled.
 	UPROPERTY(BlueprintAssignable, Category = "Procedural Dungeon")
@@ -103,10 +114,26 @@ private:
 	class UBoxComponent* RoomTrigger = nullptr;
 	TSet<TWeakObjectPtr<UObject>> Visitors;
 
+	// Transient. The actors shown and hidden by SetActorsVisible, gathered once from the level actors.
+	// The actors spawned later in the level are added when spawned (routed by the room level subsystem).
+	// The actors are hidden with SetActorHiddenInGame, so the components hidden by the gameplay are left untouched.
+	TArray<TWeakObjectPtr<AActor>> CullableActors;
+	bool bAreCullableActorsCached {false};
+	bool bAreCullableActorsVisible {true};
+
+	friend class URoomVisitorSubsystem;
+	friend class URoomLevelSubsystem;
+
 private:
+	void CreateRoomTrigger();
+	void CacheCullableActors();
+	void ResetCullableActors();
+	void OnActorSpawned(AActor* Actor);
+	static bool IsCullableActor(const AActor* Actor);
 	void UpdateBounds();
 	void UpdateVisitor(UObject* Visitor, bool IsInside);
 	void TriggerActor(AActor* Actor, bool IsInTrigger);
+	void TriggerVisitors(AActor* Actor, const TArray<UObject*>& VisitorObjects, bool IsInside);
 	virtual void PostInitProperties() override;
 
 #if WITH_EDITOR
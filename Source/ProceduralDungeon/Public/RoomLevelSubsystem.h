@@ -0,0 +1,36 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RoomLevelSubsystem.generated.h"
+
+class ARoomLevel;
+
+// Routes the actors spawned in the room levels to the room level owning their level.
+// A single spawn handler is registered in the world, and only while some room levels manage their actors visibility.
+UCLASS()
+class PROCEDURALDUNGEON_API URoomLevelSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// The room level will receive the actors spawned in its level until unregistered.
+	void RegisterRoomLevel(ARoomLevel* RoomLevel);
+	void UnregisterRoomLevel(ARoomLevel* RoomLevel);
+
+private:
+	void OnActorSpawned(AActor* Actor);
+	void RemoveActorSpawnedHandler();
+
+	TMap<TWeakObjectPtr<ULevel>, TWeakObjectPtr<ARoomLevel>> RoomLevels;
+	FDelegateHandle ActorSpawnedHandle;
+};
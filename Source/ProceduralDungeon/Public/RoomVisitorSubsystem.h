@@ -0,0 +1,65 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h" // FTimerHandle
+#include "RoomVisitorSubsystem.generated.h"
+
+class ARoomLevel;
+
+// Tracks the rooms of the registered actors by sampling their location in the dungeon grids, at the rate set in the plugin settings.
+// The actors and their components implementing IRoomVisitor receive the same events as with the room triggers,
+// which ignore the registered actors. Cheaper than the room triggers when there are a lot of moving visitors.
+// To also skip the physics overlaps with the room triggers, the collision of the actors can ignore the Room Object Type.
+UCLASS()
+class PROCEDURALDUNGEON_API URoomVisitorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Tracks the rooms the actor is in with this subsystem instead of the room triggers.
+	// The actor components implementing IRoomVisitor must be added before registering the actor.
+	// The rooms with a trigger overlapping the actor are considered already entered, so they don't dispatch a second enter event.
+	UFUNCTION(BlueprintCallable, Category = "Room Visitor")
+	void RegisterVisitor(AActor* Actor);
+
+	// Stops tracking the actor, which exits all the rooms it was in, except the ones with a trigger still overlapping it.
+	// Those room triggers will track it again and dispatch the exit event when the actor leaves them.
+	UFUNCTION(BlueprintCallable, Category = "Room Visitor")
+	void UnregisterVisitor(AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category = "Room Visitor")
+	bool IsVisitorRegistered(const AActor* Actor) const;
+
+	// Updates the rooms of all the registered actors and dispatches the enter/exit events.
+	void UpdateVisitors();
+
+private:
+	struct FVisitor
+	{
+		// The actor and its components implementing IRoomVisitor, gathered once when registered.
+		TArray<TWeakObjectPtr<UObject>> Objects;
+		TSet<TWeakObjectPtr<ARoomLevel>> RoomLevels;
+	};
+
+	// Starts, updates or stops the update timer depending on the registered actors and the settings.
+	void UpdateTimer();
+
+	// Fills the initialized room levels with a trigger overlapping the actor.
+	static void GetOverlappingRoomLevels(const AActor* Actor, TSet<ARoomLevel*>& OutRoomLevels);
+
+	void DispatchRoomEvents(AActor* Actor, FVisitor& Visitor, const TSet<ARoomLevel*>& NewRoomLevels);
+
+	TMap<TWeakObjectPtr<AActor>, FVisitor> Visitors;
+	FTimerHandle UpdateTimerHandle;
+	float CurrentUpdateInterval {0.0f};
+};
@@ -0,0 +1,32 @@
+// Copyright Benoit Pelletier 2025 All Rights Reserved.
+//
+// This software is available under different licenses depending on the source from which it was obtained:
+// - The Fab EULA (https://fab.com/eula) applies when obtained from the Fab marketplace.
+// - The CeCILL-C license (https://cecill.info/licences/Licence_CeCILL-C_V1-en.html) applies when obtained from any other source.
+// Please refer to the accompanying LICENSE file for further details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A view volume with its apex at the viewer location, narrowed each time it goes through a portal.
+// The planes are facing inward: a point is inside when its PlaneDot is positive or zero for all the planes.
+struct PROCEDURALDUNGEON_API FPortalFrustum
+{
+	FPortalFrustum() = default;
+
+	// Creates the frustum of a camera (without near and far planes).
+	// The field of view is the horizontal one, in degrees.
+	FPortalFrustum(const FVector& InOrigin, const FRotator& Rotation, float FieldOfView, float AspectRatio);
+
+	// Returns false if the quad is fully outside of the frustum.
+	// The test is conservative: some quads outside of the frustum near its corners are not rejected.
+	bool IntersectsQuad(const FVector (&Corners)[4]) const;
+
+	// Returns the part of this frustum seen through the quad.
+	// The corners must be ordered around the quad (clockwise or counter-clockwise).
+	FPortalFrustum ClipThroughQuad(const FVector (&Corners)[4]) const;
+
+	FVector Origin {FVector::ZeroVector};
+	TArray<FPlane, TInlineAllocator<16>> Planes;
+};
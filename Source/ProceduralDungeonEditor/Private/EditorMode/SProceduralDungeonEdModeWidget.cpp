@@ -22,6 +22,16 @@
 #include "GameFramework/Volume.h"
 #include "Builders/CubeBuilder.h"
 #include "Engine/Selection.h"
+#include "Engine/MeshMerging.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	#include "AssetRegistryModule.h"
+#else
+	#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+#include "IMeshMergeUtilities.h"
+#include "MeshMergeModule.h"
 #include "ProceduralDungeonEdLog.h"
 #include "ProceduralDungeonEditor.h"
 #include "ProceduralDungeonEdMode.h"
@@ -256,6 +266,24 @@ void SProceduralDungeonEdModeWidget::Construct(const FArguments& InArgs, TShared
 					.OnClicked(this, &SProceduralDungeonEdModeWidget::RemoveInvalidDoors)
 					.ToolTipText(FText::FromString(TEXT("All invalid doors (drawn in orange) will be removed.")))
 				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(5.0f, 0.0f, 0.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString(TEXT("Bake Door Visibility")))
+					.OnClicked(this, &SProceduralDungeonEdModeWidget::BakeDoorVisibility)
+					.ToolTipText(FText::FromString(TEXT("Computes which doors can be seen from each door through this room, to hide the rooms that can't be seen from the player's room.\nMust be done again after changing the room level.")))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(5.0f, 0.0f, 0.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString(TEXT("Generate Proxy Mesh")))
+					.OnClicked(this, &SProceduralDungeonEdModeWidget::GenerateProxyMesh)
+					.ToolTipText(FText::FromString(TEXT("Merges the static meshes of this room level in a single mesh, shown instead of the room when it is just beyond the occlusion distance.\nMust be done again after changing the room level.")))
+				]
 			]
 		]
 		+ SVerticalBox::Slot()
@@ -465,6 +493,84 @@ FReply SProceduralDungeonEdModeWidget::RemoveInvalidDoors()
 	return FReply::Handled();
 }
 
+FReply SProceduralDungeonEdModeWidget::BakeDoorVisibility()
+{
+	TWeakObjectPtr<URoomData> Data;
+	TWeakObjectPtr<ARoomLevel> Level;
+	if (!IsValidRoomData(nullptr, &Data, &Level))
+		return FReply::Unhandled();
+
+	GEditor->BeginTransaction(FText::FromString(TEXT("Bake Door Visibility")));
+	Data->Modify();
+	Data->BakeDoorVisibility(Level->GetWorld());
+	GEditor->EndTransaction();
+
+	return FReply::Handled();
+}
+
+FReply SProceduralDungeonEdModeWidget::GenerateProxyMesh()
+{
+	TWeakObjectPtr<URoomData> Data;
+	TWeakObjectPtr<ARoomLevel> Level;
+	if (!IsValidRoomData(nullptr, &Data, &Level))
+		return FReply::Unhandled();
+
+	// Only the actors hidden by the occlusion culling are merged.
+	TArray<UPrimitiveComponent*> Components;
+	for (AActor* Actor : Level->GetLevel()->Actors)
+	{
+		if (!IsValid(Actor) || Actor->GetIsReplicated() || Actor->ActorHasTag(FName("Ignore Room Culling")))
+			continue;
+
+		Actor->ForEachComponent<UStaticMeshComponent>(/*bIncludeFromChildActors = */ false, [&Components](UStaticMeshComponent* Component) {
+			if (IsValid(Component->GetStaticMesh()) && !Component->bHiddenInGame)
+				Components.Add(Component);
+		});
+	}
+
+	if (Components.Num() <= 0)
+	{
+		DungeonEd_LogWarning("No static mesh to merge in the room level.");
+		return FReply::Handled();
+	}
+
+	// The proxy is the cheapest version of the meshes, with a single material and the room origin as pivot.
+	FMeshMergingSettings Settings;
+	Settings.bPivotPointAtZero = true;
+	Settings.bMergePhysicsData = false;
+	Settings.bMergeMaterials = true;
+	Settings.LODSelectionType = EMeshLODSelectionType::LowestDetailLOD;
+
+	const FString PackageName = FPackageName::GetLongPackagePath(Data->GetOutermost()->GetName()) / FString::Printf(TEXT("SM_%s_Proxy"), *Data->GetName());
+	TArray<UObject*> CreatedAssets;
+	FVector MergedLocation;
+	const IMeshMergeUtilities& MeshMerge = FModuleManager::Get().LoadModuleChecked<IMeshMergeModule>("MeshMergeUtilities").GetUtilities();
+	MeshMerge.MergeComponentsToStaticMesh(Components, Level->GetWorld(), Settings, nullptr, nullptr, PackageName, CreatedAssets, MergedLocation, TNumericLimits<float>::Max(), /*bSilent = */ true);
+
+	UStaticMesh* ProxyMesh = nullptr;
+	for (UObject* Asset : CreatedAssets)
+	{
+		FAssetRegistryModule::AssetCreated(Asset);
+		if (UStaticMesh* Mesh = Cast<UStaticMesh>(Asset))
+			ProxyMesh = Mesh;
+	}
+
+	if (!ProxyMesh)
+	{
+		DungeonEd_LogError("Failed to merge the static meshes of the room level.");
+		return FReply::Handled();
+	}
+
+	GEditor->BeginTransaction(FText::FromString(TEXT("Generate Proxy Mesh")));
+	Data->Modify();
+	Data->ProxyMesh = ProxyMesh;
+	GEditor->EndTransaction();
+
+	GEditor->SyncBrowserToObjects(CreatedAssets);
+	DungeonEd_LogInfo("Generated proxy mesh %s.", *ProxyMesh->GetPathName());
+	return FReply::Handled();
+}
+
 FSlateColor SProceduralDungeonEdModeWidget::GetSaveButtonColor() const
 {
 	const FLinearColor& Default = FLinearColor::White;
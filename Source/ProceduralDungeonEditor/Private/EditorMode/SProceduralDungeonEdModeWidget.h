@@ -44,6 +44,8 @@ protected:
 	FReply SaveData();
 	FReply UpdateSelectedVolumes();
 	FReply RemoveInvalidDoors();
+	FReply BakeDoorVisibility();
+	FReply GenerateProxyMesh();
 	FSlateColor GetSaveButtonColor() const;
 	FSlateColor GetReparentButtonColor() const;
 	void UpdateErrorText();
@@ -31,6 +31,8 @@ public class ProceduralDungeonEditor : ModuleRules
 				"Slate",
 				"EditorStyle",
 				"GameplayTags",
+				"MeshMergeUtilities",
+				"AssetRegistry",
 #if UE_5_0_OR_LATER
 				"EditorFramework",
 #endif